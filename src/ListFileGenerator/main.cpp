@@ -27,30 +27,181 @@
 
 #pragma comment(linker, "/SUBSYSTEM:CONSOLE")
 
+#include <algorithm>
+#include <cstring> // memchr
 #include <iostream>
+#include <map>
+#include <vector>
 
+#include <QElapsedTimer>
 #include <QFile>
+#include <QRegularExpression>
 #include <QString>
+#include <QStringList>
 #include <QTextStream>
 
+#include "ListfileIndex.h"
+
 #define __CASCLIB_SELF__
 #include "CascLib.h"
 
+namespace
+{
+  typedef std::vector<core::ListfileIndex::Entry> Entries;
+
+  // read a listfile generated by this tool, either binary or "Name;ID" text
+  bool readListfile(const QString & filename, Entries & entries)
+  {
+    core::ListfileIndex index;
+    if (index.load(filename))
+    {
+      entries.resize(index.size());
+      for (unsigned int i = 0; i < index.size(); i++)
+      {
+        entries[i].name = QByteArray(index.name(i).constData(), index.name(i).size());
+        entries[i].id = index.id(i);
+      }
+      return true;
+    }
+
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+      std::cout << "Fail to open " << filename.toStdString() << std::endl;
+      return false;
+    }
+
+    while (!file.atEnd())
+    {
+      QByteArray line = file.readLine().trimmed().toLower();
+      int sep = line.lastIndexOf(';');
+      if (sep == -1)
+        continue;
+
+      bool ok = false;
+      core::ListfileIndex::Entry entry;
+      entry.name = line.left(sep).replace('\\', '/');
+      entry.id = line.mid(sep + 1).toUInt(&ok);
+      if (ok) // skips header
+        entries.push_back(entry);
+    }
+
+    std::sort(entries.begin(), entries.end());
+    return true;
+  }
+
+  // game build of storage in data folder, formatted as the viewer does (see CASCFolder::version)
+  QString buildVersion(const QString & dataFolder)
+  {
+    QFile file(dataFolder + "/../.build.info");
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+      return QString();
+
+    QTextStream in(&file);
+    QStringList headers = in.readLine().split('|');
+    int activeIndex = 0;
+    int versionIndex = 0;
+    for (int index = 0; index < headers.size(); index++)
+    {
+      if (headers[index].contains("Active", Qt::CaseInsensitive))
+        activeIndex = index;
+      else if (headers[index].contains("Version", Qt::CaseInsensitive))
+        versionIndex = index;
+    }
+
+    QString line;
+    while (in.readLineInto(&line))
+    {
+      QStringList values = line.split('|');
+      if (values.size() <= std::max(activeIndex, versionIndex) || values[activeIndex] == "0")
+        continue;
+
+      QRegularExpression re("^(\\d).(\\d).(\\d).(\\d+)");
+      QRegularExpressionMatch result = re.match(values[versionIndex]);
+      if (result.hasMatch())
+        return result.captured(1) + "." + result.captured(2) + "." + result.captured(3) + " (" + result.captured(4) + ")";
+    }
+
+    return QString();
+  }
+
+  int diff(const QString & oldFile, const QString & newFile)
+  {
+    Entries oldEntries, newEntries;
+    if (!readListfile(oldFile, oldEntries) || !readListfile(newFile, newEntries))
+      return 3;
+
+    // both lists are sorted by name, walk them together
+    unsigned int added = 0, removed = 0, changed = 0;
+    auto oldIt = oldEntries.begin();
+    auto newIt = newEntries.begin();
+
+    while (oldIt != oldEntries.end() || newIt != newEntries.end())
+    {
+      if (newIt == newEntries.end() || (oldIt != oldEntries.end() && oldIt->name < newIt->name))
+      {
+        std::cout << "- " << oldIt->name.constData() << ";" << oldIt->id << std::endl;
+        removed++;
+        ++oldIt;
+      }
+      else if (oldIt == oldEntries.end() || newIt->name < oldIt->name)
+      {
+        std::cout << "+ " << newIt->name.constData() << ";" << newIt->id << std::endl;
+        added++;
+        ++newIt;
+      }
+      else
+      {
+        if (oldIt->id != newIt->id)
+        {
+          std::cout << "~ " << newIt->name.constData() << ";" << oldIt->id << ";" << newIt->id << std::endl;
+          changed++;
+        }
+        ++oldIt;
+        ++newIt;
+      }
+    }
+
+    std::cout << added << " added, " << removed << " removed, " << changed << " with new id" << std::endl;
+    return 0;
+  }
+
+  void usage(const char * program)
+  {
+    std::cout << "Usage " << program << " [input listfile] [data folder] [output listfile] [--binary]" << std::endl;
+    std::cout << "      " << program << " --diff [old listfile] [new listfile]" << std::endl;
+  }
+}
+
 int main(int argc, char ** argv)
 {
-  if (argc < 4)
+  QStringList args;
+  bool binary = false;
+
+  for (int i = 1; i < argc; i++)
   {
-    std::cout << "Usage " << argv[0] << " [input listfile] [data folder] [output listfile]" << std::endl;
+    if (QString(argv[i]) == "--binary")
+      binary = true;
+    else
+      args << argv[i];
+  }
+
+  if (args.size() == 3 && args[0] == "--diff")
+    return diff(args[1], args[2]);
+
+  if (args.size() < 3)
+  {
+    usage(argv[0]);
     return 1;
   }
 
-  QString inputFile(argv[1]);
-  QString dataFoler(argv[2]);
-  QString outputFile(argv[3]);
+  QString inputFile(args[0]);
+  QString dataFoler(args[1]);
+  QString outputFile(args[2]);
 
   std::cout << "Input File : " << inputFile.toStdString() << std::endl;
   std::cout << "Data Folder : " << dataFoler.toStdString() << std::endl;
-  std::cout << "Output File : " << outputFile.toStdString() << std::endl;
+  std::cout << "Output File : " << outputFile.toStdString() << (binary ? " (binary)" : "") << std::endl;
 
   HANDLE CascStorage;
   
@@ -61,37 +212,107 @@ int main(int argc, char ** argv)
   }
 
   QFile infile(inputFile);
-  if (!infile.open(QIODevice::ReadOnly | QIODevice::Text))
+  if (!infile.open(QIODevice::ReadOnly))
   {
     std::cout << "Fail to open " << inputFile.toStdString() << std::endl;
     return 3;
   }
 
-  QFile outfile(outputFile);
-  if (!outfile.open(QIODevice::ReadWrite | QIODevice::Text))
+  QElapsedTimer timer;
+  timer.start();
+
+  // normalize names in one pass (lower case, '/' separators, as CASC storage expects)
+  QByteArray content = infile.readAll();
+  infile.close();
+
+  unsigned int nbLines = 0;
+  for (char * c = content.data(), * end = c + content.size(); c < end; ++c)
   {
-    std::cout << "Fail to open " << outputFile.toStdString() << std::endl;
-    return 4;
+    if (*c >= 'A' && *c <= 'Z')
+      *c += 'a' - 'A';
+    else if (*c == '\\')
+      *c = '/';
+    else if (*c == '\n')
+      nbLines++;
   }
 
-  QTextStream in(&infile);
-  QTextStream out(&outfile);
+  // resolve names in listfile order. CascLib doesn't document lookups on a shared storage
+  // handle as thread safe, so they are done in a single pass
+  static const unsigned int PROGRESS_STEP = 4096;
 
-  out << "Name;ID" << endl;
+  Entries entries;
+  std::string name;
+  unsigned int linesDone = 0;
+  qint64 lastProgress = 0;
 
-  while (!in.atEnd())
+  const char * end = content.constData() + content.size();
+  for (const char * line = content.constData(); line < end;)
   {
-    QString line = in.readLine().toLower();
+    const char * lineEnd = (const char *)memchr(line, '\n', end - line);
+    if (!lineEnd)
+      lineEnd = end;
 
     // just in case listfile already contains file data ids
-    QStringList list = line.split(" ");
-    QString filename = list[0];
+    const char * nameEnd = line;
+    while (nameEnd < lineEnd && *nameEnd != ' ' && *nameEnd != ';' && *nameEnd != '\r')
+      nameEnd++;
+
+    if (nameEnd > line)
+    {
+      name.assign(line, nameEnd);
+      DWORD id = CascGetFileId(CascStorage, name.c_str());
+      if (id != 0)
+      {
+        core::ListfileIndex::Entry entry;
+        entry.name = QByteArray(name.data(), (int)name.size());
+        entry.id = id;
+        entries.push_back(entry);
+      }
+    }
+
+    line = lineEnd + 1;
+
+    // report progress about once a second
+    if ((++linesDone % PROGRESS_STEP) == 0 && timer.elapsed() - lastProgress >= 1000)
+    {
+      lastProgress = timer.elapsed();
+      std::cout << linesDone << " / " << nbLines << " lines" << std::endl;
+    }
+  }
 
-    DWORD id = CascGetFileId(CascStorage, filename.toStdString().c_str());
+  CascCloseStorage(CascStorage);
 
-    if (id != 0)
-      out << filename << ";" << id << endl;
+  std::cout << entries.size() << " files resolved from " << nbLines << " lines in " << timer.elapsed()
+            << " ms" << std::endl;
+
+  if (binary)
+  {
+    // keyed with game build, viewer ignores index once game is updated
+    QString version = buildVersion(dataFoler);
+    if (version.isEmpty())
+      std::cout << "Fail to read game build from .build.info, index won't be used by viewer" << std::endl;
+
+    if (!core::ListfileIndex::save(outputFile, version.toUtf8(), entries))
+    {
+      std::cout << "Fail to write " << outputFile.toStdString() << std::endl;
+      return 4;
+    }
+    return 0;
+  }
+
+  QFile outfile(outputFile);
+  if (!outfile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+  {
+    std::cout << "Fail to open " << outputFile.toStdString() << std::endl;
+    return 4;
   }
 
+  QTextStream out(&outfile);
+
+  out << "Name;ID" << endl;
+
+  for (auto & it : entries)
+    out << it.name << ";" << it.id << endl;
+
   return 0;
 }
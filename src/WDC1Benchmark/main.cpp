@@ -0,0 +1,120 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+
+/*
+ * main.cpp
+ *
+ *  Created on: 18 Oct 2026
+ *   Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+ */
+
+
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QString>
+
+#include "wdc1file.h"
+
+// compares WDC1File column unpacking against per record extraction, on synthetic records
+// (random bits), for a range of field sizes and bit offsets. Exit code is 1 if values differ
+namespace
+{
+  const unsigned int RECORD_SIZE = 32; // bytes
+
+  void usage(const char * program)
+  {
+    std::cout << "Usage " << program << " [record count (default 100000)] [runs (default 20)]" << std::endl;
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  unsigned int recordCount = 100000;
+  int runs = 20;
+
+  if (argc > 3)
+  {
+    usage(argv[0]);
+    return 1;
+  }
+
+  if (argc > 1)
+    recordCount = QString(argv[1]).toUInt();
+
+  if (argc > 2)
+    runs = QString(argv[2]).toInt();
+
+  if (recordCount == 0 || runs <= 0)
+  {
+    usage(argv[0]);
+    return 1;
+  }
+
+  std::vector<unsigned char> data(recordCount * RECORD_SIZE);
+  std::mt19937 generator(1234);
+  for (auto & byte : data)
+    byte = static_cast<unsigned char>(generator());
+
+  std::vector<const unsigned char *> records(recordCount);
+  for (unsigned int i = 0; i < recordCount; i++)
+    records[i] = data.data() + i * RECORD_SIZE;
+
+  const unsigned char * dataEnd = data.data() + data.size();
+
+  std::vector<uint32> columnValues(recordCount);
+  std::vector<uint32> scalarValues(recordCount);
+
+  const uint32 bitSizes[] = { 1, 3, 8, 12, 16, 17, 24, 31, 32 };
+  const uint32 bitOffsets[] = { 0, 5, 64, 131, 255 - 32 };
+
+  bool differ = false;
+
+  for (uint32 bitSize : bitSizes)
+  {
+    for (uint32 bitOffset : bitOffsets)
+    {
+      QElapsedTimer timer;
+      timer.start();
+      for (int run = 0; run < runs; run++)
+        WDC1File::unpackBits(records.data(), recordCount, bitOffset, bitSize, dataEnd, columnValues.data());
+      qint64 columnTime = timer.nsecsElapsed();
+
+      timer.restart();
+      for (int run = 0; run < runs; run++)
+      {
+        for (unsigned int i = 0; i < recordCount; i++)
+          scalarValues[i] = WDC1File::readBits(records[i], bitOffset, bitSize);
+      }
+      qint64 scalarTime = timer.nsecsElapsed();
+
+      bool same = (columnValues == scalarValues);
+      differ = differ || !same;
+
+      std::cout << bitSize << " bits at " << bitOffset << " : column " << columnTime / 1000 << " us, scalar "
+                << scalarTime / 1000 << " us" << (same ? "" : " - VALUES DIFFER") << std::endl;
+    }
+  }
+
+  return differ ? 1 : 0;
+}
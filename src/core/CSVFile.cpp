@@ -2,49 +2,164 @@
 
 #include "logger/Logger.h"
 
-#include <QFile>
+#include <algorithm>
+#include <cstdlib> // strtod
+#include <cstring> // memchr
+
+#include "Game.h"
+
+namespace
+{
+  // split [begin, end) line on ';', memchr being vectorized by runtime libraries
+  template <class Callback>
+  void splitLine(const char * begin, const char * end, Callback callback)
+  {
+    if (end > begin && *(end - 1) == '\r')
+      end--;
+
+    for (;;)
+    {
+      const char * separator = static_cast<const char *>(memchr(begin, ';', end - begin));
+      if (!separator)
+      {
+        callback(begin, end);
+        break;
+      }
+
+      callback(begin, separator);
+      begin = separator + 1;
+    }
+  }
+
+  qint64 toInteger(const char * value, unsigned int size)
+  {
+    const char * end = value + size;
+    bool negative = (value < end && *value == '-');
+    if (negative)
+      value++;
+
+    qint64 result = 0;
+    for (; value < end && *value >= '0' && *value <= '9'; value++)
+      result = result * 10 + (*value - '0');
+
+    return negative ? -result : result;
+  }
+
+  double toReal(const char * value, unsigned int size)
+  {
+    char buffer[64];
+    size = std::min(size, (unsigned int)sizeof(buffer) - 1);
+    memcpy(buffer, value, size);
+    buffer[size] = 0;
+    return strtod(buffer, 0);
+  }
+}
 
 CSVFile::CSVFile(const QString & file) :
-DBFile(), m_file(file)
+DBFile(), m_file(file), m_data(0), m_columnsStructure(0)
 {
 }
 
 bool CSVFile::open()
 {
-  QFile file(core::Game::instance().configFolder() + m_file);
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+  m_mappedFile.setFileName(core::Game::instance().configFolder() + m_file);
+  if (!m_mappedFile.open(QIODevice::ReadOnly))
   {
     LOG_ERROR << "Fail to open" << m_file;
     return false;
   }
 
-  QTextStream in(&file);
-
-  // read first line to gather fields' position
-  QStringList list = in.readLine().toLower().split(";");
+  qint64 size = m_mappedFile.size();
+  m_data = reinterpret_cast<const char *>(m_mappedFile.map(0, size));
 
-  for (auto it : list)
-    m_fields.push_back(it);
-  
-  while (!in.atEnd())
+  if (!m_data)
   {
-    QStringList list = in.readLine().split(";");
+    m_content = m_mappedFile.readAll();
+    m_data = m_content.constData();
+  }
+
+  const char * begin = m_data;
+  const char * end = m_data + size;
 
-    std::vector<std::string> vals;
+  m_fields.clear();
+  m_cells.clear();
+  m_recordCells.clear();
+  recordCount = 0;
 
-    for (auto it : list)
-      vals.push_back(it.toStdString());
+  bool header = true;
 
-    m_values.push_back(vals);
+  while (begin < end)
+  {
+    const char * lineEnd = static_cast<const char *>(memchr(begin, '\n', end - begin));
+    if (!lineEnd)
+      lineEnd = end;
+
+    if (header)
+    {
+      // first line gives fields' position
+      splitLine(begin, lineEnd, [this](const char * cellBegin, const char * cellEnd)
+      {
+        m_fields.push_back(QString::fromUtf8(cellBegin, (int)(cellEnd - cellBegin)).toLower());
+      });
+
+      header = false;
+    }
+    else if (lineEnd > begin && !(lineEnd == begin + 1 && *begin == '\r'))
+    {
+      m_recordCells.push_back((unsigned int)m_cells.size());
+
+      splitLine(begin, lineEnd, [this](const char * cellBegin, const char * cellEnd)
+      {
+        Cell c;
+        c.offset = (unsigned int)(cellBegin - m_data);
+        c.size = (unsigned int)(cellEnd - cellBegin);
+        m_cells.push_back(c);
+      });
+
+      recordCount++;
+    }
+
+    begin = lineEnd + 1;
+  }
 
-    recordCount++;
+  m_recordCells.push_back((unsigned int)m_cells.size());
+
+  // records ids are read from "id" column, or first one if there is none
+  int idColumn = 0;
+  for (unsigned int i = 0; i < m_fields.size(); i++)
+  {
+    if (m_fields[i] == "id")
+      idColumn = i;
   }
 
+  std::vector<unsigned int> ids;
+  ids.reserve(recordCount);
+  for (unsigned int i = 0; i < recordCount; i++)
+  {
+    Cell c = cell(i, idColumn);
+    ids.push_back((unsigned int)toInteger(m_data + c.offset, c.size));
+  }
+
+  setRecordIds(ids);
+
   return true;
 }
 
 bool CSVFile::close()
 {
+  if (m_mappedFile.isOpen())
+  {
+    if (m_data && m_content.isEmpty())
+      m_mappedFile.unmap(reinterpret_cast<uchar *>(const_cast<char *>(m_data)));
+
+    m_mappedFile.close();
+  }
+
+  m_data = 0;
+  m_content.clear();
+  m_cells.clear();
+  m_recordCells.clear();
+
   return true;
 }
 
@@ -53,20 +168,86 @@ CSVFile::~CSVFile()
   close();
 }
 
-std::vector<std::string> CSVFile::get(unsigned int recordIndex, const core::TableStructure * structure) const
+const std::vector<CSVFile::FieldColumn> & CSVFile::columns(const core::TableStructure * structure) const
 {
-  std::vector<std::string> result;
+  if (structure == m_columnsStructure)
+    return m_columns;
+
+  m_columns.clear();
+  m_columnsStructure = structure;
 
   for (auto it : structure->fields)
   {
-    uint fieldIndex = 0;
-    
-    for (; fieldIndex < m_fields.size(); fieldIndex++)
-      if (it->name.toLower() == m_fields[fieldIndex])
+    QString name = it->name.toLower();
+
+    FieldColumn f;
+    f.column = -1;
+
+    for (unsigned int i = 0; i < m_fields.size(); i++)
+    {
+      if (m_fields[i] == name)
+      {
+        f.column = i;
         break;
+      }
+    }
+
+    if (f.column == -1)
+      LOG_ERROR << "Field" << it->name << "not found in" << m_file;
+
+    if (it->type == "text")
+      f.type = FieldColumn::TEXT_VALUE;
+    else if (it->type == "float")
+      f.type = FieldColumn::REAL_VALUE;
+    else
+      f.type = FieldColumn::INT_VALUE;
+
+    m_columns.push_back(f);
+  }
+
+  return m_columns;
+}
+
+CSVFile::Cell CSVFile::cell(unsigned int recordIndex, int column) const
+{
+  unsigned int first = m_recordCells[recordIndex];
 
-    result.push_back(m_values[recordIndex][fieldIndex]);
+  if (column < 0 || first + column >= m_recordCells[recordIndex + 1])
+  {
+    Cell empty;
+    empty.offset = 0;
+    empty.size = 0;
+    return empty;
+  }
+
+  return m_cells[first + column];
+}
+
+std::vector<std::string> CSVFile::get(unsigned int recordIndex, const core::TableStructure * structure) const
+{
+  std::vector<std::string> result;
+
+  for (const FieldColumn & f : columns(structure))
+  {
+    Cell c = cell(recordIndex, f.column);
+    result.push_back(std::string(m_data + c.offset, c.size));
   }
 
   return result;
 }
+
+void CSVFile::writeRecord(unsigned int recordIndex, const core::TableStructure * structure, DBRecordWriter & writer) const
+{
+  for (const FieldColumn & f : columns(structure))
+  {
+    Cell c = cell(recordIndex, f.column);
+    const char * value = m_data + c.offset;
+
+    if (f.type == FieldColumn::TEXT_VALUE)
+      writer.writeText(value, (int)c.size);
+    else if (f.type == FieldColumn::REAL_VALUE)
+      writer.writeReal(toReal(value, c.size));
+    else
+      writer.writeInt(toInteger(value, c.size));
+  }
+}
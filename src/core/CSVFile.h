@@ -1,6 +1,8 @@
 #ifndef CSVFILE_H
 #define CSVFILE_H
 
+#include <QByteArray>
+#include <QFile>
 #include <QString>
 
 #include "dbfile.h"
@@ -16,6 +18,8 @@
 #endif
 
 
+// ';' separated values file, first line giving columns names. File is memory mapped and
+// cells are located in place : values are read straight from file content, never copied
 class _CSVFILE_API_ CSVFile : public DBFile
 {
 public:
@@ -28,12 +32,44 @@ public:
   bool close();
 
   std::vector<std::string> get(unsigned int recordIndex, const core::TableStructure * structure) const;
+  void writeRecord(unsigned int recordIndex, const core::TableStructure * structure, DBRecordWriter & writer) const;
 
 private:
+  struct Cell
+  {
+    unsigned int offset; // in file content
+    unsigned int size;
+  };
+
+  // file column and value type of each structure field, resolved once per structure
+  struct FieldColumn
+  {
+    enum Type
+    {
+      INT_VALUE,
+      REAL_VALUE,
+      TEXT_VALUE
+    };
+
+    int column; // -1 if field is not in file
+    Type type;
+  };
+
+  const std::vector<FieldColumn> & columns(const core::TableStructure * structure) const;
+  // empty cell if column is missing on this line
+  Cell cell(unsigned int recordIndex, int column) const;
+
   QString m_file;
+  QFile m_mappedFile;
+  QByteArray m_content; // used when file can't be mapped
+  const char * m_data;
+
   std::vector<QString> m_fields;
-  std::vector<std::vector<std::string> > m_values;
+  std::vector<Cell> m_cells;
+  std::vector<unsigned int> m_recordCells; // first cell of each record, plus end of cells
 
+  mutable std::vector<FieldColumn> m_columns;
+  mutable const core::TableStructure * m_columnsStructure;
 };
 
 #endif
@@ -0,0 +1,102 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+/*
+* ChunkDirectory.cpp
+*
+*  Created on: 18 Oct 2026
+*  Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+*/
+
+#include "ChunkDirectory.h"
+
+#include <cstring> // memcpy
+
+std::string core::fourccName(unsigned int magic)
+{
+  char name[4];
+  memcpy(name, &magic, 4);
+  return std::string(name, 4);
+}
+
+void core::ChunkDirectory::build(const unsigned char * data, unsigned int begin, unsigned int end, bool reversedMagic)
+{
+  clear();
+
+  if (!data)
+    return;
+
+  unsigned int offset = begin;
+
+  while (offset + 8 <= end)
+  {
+    Chunk chunk;
+    memcpy(&chunk.magic, data + offset, 4);
+    memcpy(&chunk.size, data + offset + 4, 4);
+
+    if (reversedMagic)
+      chunk.magic = ((chunk.magic & 0x000000FF) << 24) | ((chunk.magic & 0x0000FF00) << 8) |
+                    ((chunk.magic & 0x00FF0000) >> 8) | ((chunk.magic & 0xFF000000) >> 24);
+
+    chunk.start = offset + 8;
+    chunk.pointer = 0;
+
+    if (chunk.size > end - chunk.start)
+      break;
+
+    add(chunk.magic, chunk.start, chunk.size);
+
+    offset = chunk.start + chunk.size;
+  }
+}
+
+void core::ChunkDirectory::add(unsigned int magic, unsigned int start, unsigned int size)
+{
+  Chunk chunk;
+  chunk.magic = magic;
+  chunk.start = start;
+  chunk.size = size;
+  chunk.pointer = 0;
+
+  m_index.insert(std::make_pair(magic, m_chunks.size())); // keep first occurence only
+  m_chunks.push_back(chunk);
+}
+
+void core::ChunkDirectory::clear()
+{
+  m_chunks.clear();
+  m_index.clear();
+}
+
+core::ChunkDirectory::Chunk * core::ChunkDirectory::find(unsigned int magic)
+{
+  auto it = m_index.find(magic);
+  if (it == m_index.end())
+    return 0;
+
+  return &m_chunks[it->second];
+}
+
+const core::ChunkDirectory::Chunk * core::ChunkDirectory::find(unsigned int magic) const
+{
+  auto it = m_index.find(magic);
+  if (it == m_index.end())
+    return 0;
+
+  return &m_chunks[it->second];
+}
@@ -0,0 +1,101 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+/*
+* ChunkDirectory.h
+*
+*  Created on: 18 Oct 2026
+*  Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+*/
+
+#ifndef _CHUNKDIRECTORY_H_
+#define _CHUNKDIRECTORY_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ChunkView.h"
+
+#ifdef _WIN32
+#    ifdef BUILDING_CORE_DLL
+#        define _CHUNKDIRECTORY_API_ __declspec(dllexport)
+#    else
+#        define _CHUNKDIRECTORY_API_ __declspec(dllimport)
+#    endif
+#else
+#    define _CHUNKDIRECTORY_API_
+#endif
+
+namespace core
+{
+  // pack a chunk name into an integer, ie fourcc("MD21")
+  constexpr unsigned int fourcc(const char * name)
+  {
+    return (unsigned int)(unsigned char)name[0] |
+           ((unsigned int)(unsigned char)name[1] << 8) |
+           ((unsigned int)(unsigned char)name[2] << 16) |
+           ((unsigned int)(unsigned char)name[3] << 24);
+  }
+
+  _CHUNKDIRECTORY_API_ std::string fourccName(unsigned int magic);
+
+  // List of chunks found in a file buffer, built once at open time.
+  class _CHUNKDIRECTORY_API_ ChunkDirectory
+  {
+    public:
+      struct Chunk
+      {
+        unsigned int magic;
+        unsigned int start;   // offset of chunk data (after header) in buffer
+        unsigned int size;
+        unsigned int pointer; // read position saved when leaving chunk
+      };
+
+      typedef std::vector<Chunk>::iterator iterator;
+      typedef std::vector<Chunk>::const_iterator const_iterator;
+
+      // scan chunks stored in data[begin, end[. Some formats (WMO, ADT) store chunk name
+      // reversed on disk, they are flipped back so that lookups always use fourcc("MOGP") like names.
+      // Scan stops at first chunk overflowing given range.
+      void build(const unsigned char * data, unsigned int begin, unsigned int end, bool reversedMagic = false);
+      // register a chunk located through an external index (e.g. ADT MCNK header offsets)
+      void add(unsigned int magic, unsigned int start, unsigned int size);
+      void clear();
+
+      // first chunk with given name, 0 if none
+      Chunk * find(unsigned int magic);
+      const Chunk * find(unsigned int magic) const;
+      bool contains(unsigned int magic) const { return find(magic) != 0; }
+
+      size_t size() const { return m_chunks.size(); }
+      bool empty() const { return m_chunks.empty(); }
+      Chunk & operator[](size_t index) { return m_chunks[index]; }
+
+      iterator begin() { return m_chunks.begin(); }
+      iterator end() { return m_chunks.end(); }
+      const_iterator begin() const { return m_chunks.begin(); }
+      const_iterator end() const { return m_chunks.end(); }
+
+    private:
+      std::vector<Chunk> m_chunks; // in file order
+      std::unordered_map<unsigned int, size_t> m_index; // name => position in m_chunks
+  };
+}
+
+#endif /* _CHUNKDIRECTORY_H_ */
@@ -0,0 +1,89 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+/*
+* ChunkView.h
+*
+*  Created on: 18 Oct 2026
+*  Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+*/
+
+#ifndef _CHUNKVIEW_H_
+#define _CHUNKVIEW_H_
+
+#include <cassert>
+#include <cstddef>
+
+namespace core
+{
+  // Read only typed view over (part of) a chunk, pointing directly into file buffer.
+  // View is only valid as long as file it comes from is opened.
+  template <class T>
+  class ChunkView
+  {
+    public:
+      ChunkView()
+        : m_data(0), m_count(0)
+      {}
+
+      ChunkView(const unsigned char * data, size_t bytes)
+        : m_data(reinterpret_cast<const T *>(data)), m_count(data ? bytes / sizeof(T) : 0)
+      {}
+
+      size_t size() const { return m_count; }
+      bool empty() const { return m_count == 0; }
+
+      const T * data() const { return m_data; }
+      const T * begin() const { return m_data; }
+      const T * end() const { return m_data + m_count; }
+
+      const T & operator[](size_t index) const
+      {
+        assert(index < m_count);
+        return m_data[index];
+      }
+
+      // copy element at given index into value, if it exists
+      bool get(size_t index, T & value) const
+      {
+        if (index >= m_count)
+          return false;
+
+        value = m_data[index];
+        return true;
+      }
+
+      // view over "count" elements of type U starting at "offset" bytes from the beginning
+      // of this view (typical M2 ofsXXX / nXXX pair). Empty view if it doesn't fit.
+      template <class U>
+      ChunkView<U> sub(size_t offset, size_t count) const
+      {
+        size_t bytes = m_count * sizeof(T);
+        if (offset > bytes || count > (bytes - offset) / sizeof(U))
+          return ChunkView<U>();
+
+        return ChunkView<U>(reinterpret_cast<const unsigned char *>(m_data) + offset, count * sizeof(U));
+      }
+
+    private:
+      const T * m_data;
+      size_t m_count;
+  };
+}
+
+#endif /* _CHUNKVIEW_H_ */
@@ -0,0 +1,356 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+/*
+* ColumnTable.cpp
+*
+*  Created on: 18 Oct 2026
+*  Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+*/
+
+#include "ColumnTable.h"
+
+#include <algorithm>
+
+#include "dbfile.h"
+#include "GameDatabase.h"
+#include "SqlQuery.h"
+#include "logger/Logger.h"
+
+// feeds decoded values of a record to columns, in column order
+class core::ColumnTable::Filler : public DBRecordWriter
+{
+  public:
+    explicit Filler(ColumnTable & table) : m_table(table), m_column(0), m_overflow(false) {}
+
+    // some record gave more values than table has columns
+    bool overflow() const { return m_overflow; }
+
+    void beginRecord(unsigned int) { m_column = 0; }
+
+    void writeInt(qint64 value)
+    {
+      Column & c = next();
+      if (c.type == INT_COLUMN)
+        c.integers.push_back(value);
+      else if (c.type == REAL_COLUMN)
+        c.reals.push_back((double)value);
+      else
+        appendText(c, QByteArray::number(value));
+    }
+
+    void writeReal(double value)
+    {
+      Column & c = next();
+      if (c.type == INT_COLUMN)
+        c.integers.push_back((qint64)value);
+      else if (c.type == REAL_COLUMN)
+        c.reals.push_back(value);
+      else
+        appendText(c, QByteArray::number(value));
+    }
+
+    void writeText(const char * value, int size)
+    {
+      Column & c = next();
+      if (c.type == INT_COLUMN)
+        c.integers.push_back(QByteArray::fromRawData(value, size).toLongLong());
+      else if (c.type == REAL_COLUMN)
+        c.reals.push_back(QByteArray::fromRawData(value, size).toDouble());
+      else
+        appendText(c, QByteArray::fromRawData(value, size));
+    }
+
+  private:
+    Column & next()
+    {
+      // record layout doesn't match table structure, extra values are dropped
+      if (m_column >= m_table.m_columns.size())
+      {
+        m_overflow = true;
+        m_spare = Column();
+        return m_spare;
+      }
+
+      return m_table.m_columns[m_column++];
+    }
+
+    static void appendText(Column & c, const QByteArray & value)
+    {
+      c.texts.append(value);
+      c.textOffsets.push_back((unsigned int)c.texts.size());
+    }
+
+    ColumnTable & m_table;
+    unsigned int m_column;
+    bool m_overflow;
+    Column m_spare;
+};
+
+const unsigned int core::ColumnTable::npos;
+
+core::ColumnTable::ColumnTable(const TableStructure * structure)
+  : m_structure(structure), m_name(structure->name), m_columnNames(structure->columnNames()), m_keyColumn(-1), m_nbRows(0), m_minKey(0)
+{
+  for (auto field : structure->fields)
+  {
+    Column c;
+
+    if (field->type == "float")
+      c.type = REAL_COLUMN;
+    else if (field->type == "text")
+      c.type = TEXT_COLUMN;
+
+    c.indexed = field->needIndex;
+
+    if (field->isKey)
+      m_keyColumn = (int)m_columns.size();
+
+    for (unsigned int i = 0; i < field->arraySize; i++)
+      m_columns.push_back(c);
+  }
+}
+
+bool core::ColumnTable::fill(const DBFile * file)
+{
+  if (!file)
+    return false;
+
+  unsigned int nbRecords = (unsigned int)file->getRecordCount();
+
+  clearValues(nbRecords);
+
+  Filler filler(*this);
+  file->decodeRange(0, nbRecords, m_structure, filler);
+
+  if (!checkValues(filler, nbRecords))
+  {
+    m_nbRows = 0;
+    return false;
+  }
+
+  m_nbRows = nbRecords;
+
+  buildIndexes();
+
+  return true;
+}
+
+bool core::ColumnTable::fill(SqlQuery & query)
+{
+  if (!query.isValid() || query.columnCount() != (int)m_columns.size())
+    return false;
+
+  clearValues(0);
+
+  Filler filler(*this);
+  unsigned int nbRecords = 0;
+
+  while (query.next())
+  {
+    filler.beginRecord(nbRecords);
+
+    for (int i = 0; i < (int)m_columns.size(); i++)
+    {
+      if (m_columns[i].type == INT_COLUMN)
+      {
+        filler.writeInt(query.int64(i));
+      }
+      else if (m_columns[i].type == REAL_COLUMN)
+      {
+        filler.writeReal(query.real(i));
+      }
+      else
+      {
+        QByteArray value = query.textView(i);
+        filler.writeText(value.constData(), value.size());
+      }
+    }
+
+    nbRecords++;
+  }
+
+  if (query.hasError() || !checkValues(filler, nbRecords))
+  {
+    m_nbRows = 0;
+    return false;
+  }
+
+  m_nbRows = nbRecords;
+
+  buildIndexes();
+
+  return true;
+}
+
+void core::ColumnTable::clearValues(unsigned int nbRecords)
+{
+  for (auto & c : m_columns)
+  {
+    c.integers.clear();
+    c.reals.clear();
+    c.texts.clear();
+    c.textOffsets.assign(1, 0);
+
+    if (c.type == INT_COLUMN)
+      c.integers.reserve(nbRecords);
+    else if (c.type == REAL_COLUMN)
+      c.reals.reserve(nbRecords);
+    else
+      c.textOffsets.reserve(nbRecords + 1);
+  }
+}
+
+bool core::ColumnTable::checkValues(const Filler & filler, unsigned int nbRecords) const
+{
+  if (filler.overflow())
+  {
+    LOG_ERROR << "In memory table" << m_name << ": records hold more values than table has columns";
+    return false;
+  }
+
+  for (unsigned int i = 0; i < m_columns.size(); i++)
+  {
+    const Column & c = m_columns[i];
+    size_t nbValues = (c.type == INT_COLUMN) ? c.integers.size() :
+                      (c.type == REAL_COLUMN) ? c.reals.size() : c.textOffsets.size() - 1;
+
+    if (nbValues != nbRecords)
+    {
+      LOG_ERROR << "In memory table" << m_name << ": column" << m_columnNames.value(i) << "got"
+                << nbValues << "values for" << nbRecords << "records";
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void core::ColumnTable::buildIndexes()
+{
+  m_denseKeys.clear();
+  m_sparseKeys.clear();
+
+  if (m_keyColumn != -1 && m_columns[m_keyColumn].type == INT_COLUMN && m_nbRows)
+  {
+    const std::vector<qint64> & keys = m_columns[m_keyColumn].integers;
+    auto minmax = std::minmax_element(keys.begin(), keys.end());
+    m_minKey = *minmax.first;
+
+    // dense array as long as it isn't much larger than a hash would be
+    qint64 range = *minmax.second - m_minKey + 1;
+    if (range <= 4 * (qint64)m_nbRows + 1024)
+    {
+      m_denseKeys.assign((size_t)range, npos);
+      for (unsigned int row = 0; row < m_nbRows; row++)
+      {
+        unsigned int & slot = m_denseKeys[(size_t)(keys[row] - m_minKey)];
+        if (slot == npos)
+          slot = row;
+      }
+    }
+    else
+    {
+      m_sparseKeys.reserve(m_nbRows);
+      for (unsigned int row = 0; row < m_nbRows; row++)
+        m_sparseKeys.insert(std::make_pair(keys[row], row));
+    }
+  }
+
+  for (auto & c : m_columns)
+  {
+    c.index.clear();
+
+    if (!c.indexed || c.type != INT_COLUMN)
+      continue;
+
+    c.index.reserve(m_nbRows);
+    for (unsigned int row = 0; row < m_nbRows; row++)
+      c.index.push_back(std::make_pair(c.integers[row], row));
+
+    // (value, row) pairs : rows with same value stay in file order
+    std::sort(c.index.begin(), c.index.end());
+  }
+}
+
+int core::ColumnTable::column(const QString & name) const
+{
+  return m_columnNames.indexOf(name);
+}
+
+unsigned int core::ColumnTable::find(qint64 key) const
+{
+  if (!m_denseKeys.empty())
+  {
+    if (key < m_minKey || key - m_minKey >= (qint64)m_denseKeys.size())
+      return npos;
+
+    return m_denseKeys[(size_t)(key - m_minKey)];
+  }
+
+  auto it = m_sparseKeys.find(key);
+  return (it != m_sparseKeys.end()) ? it->second : npos;
+}
+
+std::vector<unsigned int> core::ColumnTable::findAll(int column, qint64 value) const
+{
+  std::vector<unsigned int> result;
+
+  if (column < 0 || column >= (int)m_columns.size())
+    return result;
+
+  if (column == m_keyColumn)
+  {
+    unsigned int row = find(value);
+    if (row != npos)
+      result.push_back(row);
+    return result;
+  }
+
+  const Column & c = m_columns[column];
+  if (c.type != INT_COLUMN)
+    return result;
+
+  if (c.indexed)
+  {
+    auto range = std::equal_range(c.index.begin(), c.index.end(), std::make_pair(value, 0u),
+                                  [](const std::pair<qint64, unsigned int> & a, const std::pair<qint64, unsigned int> & b)
+                                  {
+                                    return a.first < b.first;
+                                  });
+
+    for (auto it = range.first; it != range.second; ++it)
+      result.push_back(it->second);
+  }
+  else
+  {
+    for (unsigned int row = 0; row < m_nbRows; row++)
+    {
+      if (c.integers[row] == value)
+        result.push_back(row);
+    }
+  }
+
+  return result;
+}
+
+QString core::ColumnTable::text(unsigned int row, int column) const
+{
+  const Column & c = m_columns[column];
+  return QString::fromUtf8(c.texts.constData() + c.textOffsets[row], c.textOffsets[row + 1] - c.textOffsets[row]);
+}
@@ -0,0 +1,132 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+/*
+* ColumnTable.h
+*
+*  Created on: 18 Oct 2026
+*  Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+*/
+
+#ifndef _COLUMNTABLE_H_
+#define _COLUMNTABLE_H_
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+
+class DBFile;
+
+#ifdef _WIN32
+#    ifdef BUILDING_CORE_DLL
+#        define _COLUMNTABLE_API_ __declspec(dllexport)
+#    else
+#        define _COLUMNTABLE_API_ __declspec(dllimport)
+#    endif
+#else
+#    define _COLUMNTABLE_API_
+#endif
+
+namespace core
+{
+  class SqlQuery;
+  class TableStructure;
+
+  // Database table kept in memory as typed columns, decoded straight from game file (no sql, no
+  // string conversion), or read back from sql table when database was restored from snapshot.
+  // Rows are found by primary key through a dense array (or a hash when keys are too sparse),
+  // and by value of fields declared with createIndex="yes" through sorted indexes.
+  // Read only once filled, so it can be used from any thread without locking.
+  class _COLUMNTABLE_API_ ColumnTable
+  {
+    public:
+      static const unsigned int npos = 0xFFFFFFFF;
+
+      explicit ColumnTable(const TableStructure * structure);
+
+      // decode all records of file and build indexes. Fails if records don't give exactly one
+      // value per column, table must then not be used (lookups go through sql instead)
+      bool fill(const DBFile * file);
+      // same, from rows of a query selecting table columns (see TableStructure::columnNames) in
+      // that order, rows being kept in query order. Used when sql table is already filled, to avoid
+      // decoding game file again
+      bool fill(SqlQuery & query);
+
+      QString name() const { return m_name; }
+      unsigned int rowCount() const { return m_nbRows; }
+
+      // column index from sql column name (array fields being expanded : name1, name2, ...), -1 if not found
+      int column(const QString & name) const;
+
+      // row with given primary key, npos if none
+      unsigned int find(qint64 key) const;
+      // rows with given value in column, in file order. Uses index when column has one, scans column otherwise
+      std::vector<unsigned int> findAll(int column, qint64 value) const;
+
+      qint64 integer(unsigned int row, int column) const { return m_columns[column].integers[row]; }
+      double real(unsigned int row, int column) const { return m_columns[column].reals[row]; }
+      QString text(unsigned int row, int column) const;
+
+    private:
+      enum ColumnType
+      {
+        INT_COLUMN,
+        REAL_COLUMN,
+        TEXT_COLUMN
+      };
+
+      struct Column
+      {
+        Column() : type(INT_COLUMN), indexed(false) {}
+
+        ColumnType type;
+        bool indexed;
+        std::vector<qint64> integers;
+        std::vector<double> reals;
+        std::vector<unsigned int> textOffsets; // rowCount + 1 offsets in texts
+        QByteArray texts;
+        std::vector<std::pair<qint64, unsigned int> > index; // (value, row), sorted
+      };
+
+      class Filler;
+
+      // empty all columns, reserving room for given number of records
+      void clearValues(unsigned int nbRecords);
+      // every column got one value per record
+      bool checkValues(const Filler & filler, unsigned int nbRecords) const;
+      void buildIndexes();
+
+      const TableStructure * m_structure;
+      QString m_name;
+      QStringList m_columnNames;
+      std::vector<Column> m_columns;
+      int m_keyColumn;
+      unsigned int m_nbRows;
+
+      // primary key index : dense one when keys are compact enough, hash one otherwise
+      qint64 m_minKey;
+      std::vector<unsigned int> m_denseKeys;
+      std::unordered_map<qint64, unsigned int> m_sparseKeys;
+  };
+}
+
+#endif /* _COLUMNTABLE_H_ */
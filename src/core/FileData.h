@@ -0,0 +1,72 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+/*
+* FileData.h
+*
+*  Created on: 18 Oct 2026
+*  Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+*/
+
+#ifndef _FILEDATA_H_
+#define _FILEDATA_H_
+
+#include <memory>
+
+#include "ChunkDirectory.h"
+#include "GameFileCache.h" // GameFileBuffer
+
+#ifdef _WIN32
+#    ifdef BUILDING_CORE_DLL
+#        define _FILEDATA_API_ __declspec(dllexport)
+#    else
+#        define _FILEDATA_API_ __declspec(dllimport)
+#    endif
+#else
+#    define _FILEDATA_API_
+#endif
+
+namespace core
+{
+  // Decoded content of a game file, along with its chunks. Never modified once built,
+  // so it can be shared between threads and read through as many FileReader as needed.
+  class _FILEDATA_API_ FileData
+  {
+    public:
+      FileData(GameFileBuffer buffer, unsigned int size);
+
+      const unsigned char * data() const { return m_buffer.get(); }
+      unsigned int size() const { return m_size; }
+
+      const ChunkDirectory & chunks() const { return m_chunks; }
+      // only meant to be used by creator, before sharing data
+      ChunkDirectory & chunks() { return m_chunks; }
+
+    private:
+      FileData(const FileData &);
+      void operator=(const FileData &);
+
+      GameFileBuffer m_buffer;
+      unsigned int m_size;
+      ChunkDirectory m_chunks;
+  };
+
+  typedef std::shared_ptr<const FileData> FileDataPtr;
+}
+
+#endif /* _FILEDATA_H_ */
@@ -0,0 +1,137 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+/*
+* FileNameIndex.cpp
+*
+*  Created on: 18 Oct 2026
+*  Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+*/
+
+#include "FileNameIndex.h"
+
+#include <algorithm>
+
+core::FileNameIndex::FileNameIndex()
+  : m_generation(1)
+{
+}
+
+void core::FileNameIndex::add(const QByteArray & name, unsigned int handle)
+{
+  int dot = name.lastIndexOf('.');
+  std::string extension = (dot != -1) ? name.mid(dot + 1).toStdString() : std::string();
+
+  Bucket & bucket = m_buckets[extension];
+  unsigned int position = (unsigned int)bucket.handles.size();
+
+  bucket.handles.push_back(handle);
+  bucket.names.push_back(name);
+
+  for (int i = 0; i + 3 <= name.size(); i++)
+  {
+    std::vector<unsigned int> & posting = bucket.postings[trigram(name.constData() + i)];
+    // same trigram can appear several times in a name
+    if (posting.empty() || posting.back() != position)
+      posting.push_back(position);
+  }
+
+  m_generation++;
+}
+
+void core::FileNameIndex::clear()
+{
+  m_buckets.clear();
+  m_generation++;
+}
+
+void core::FileNameIndex::search(Result & result, const QString & text, const QString & extension) const
+{
+  QByteArray searched = text.toLower().toUtf8();
+  std::string ext = extension.toLower().toStdString();
+
+  bool narrowing = (result.m_generation == m_generation) &&
+                   (result.m_extension == ext) &&
+                   searched.contains(result.m_text);
+
+  result.m_generation = m_generation;
+  result.m_extension = ext;
+  result.m_text = searched;
+  result.m_handles.clear();
+
+  auto bucketIt = m_buckets.find(ext);
+  if (bucketIt == m_buckets.end())
+  {
+    result.m_matches.clear();
+    return;
+  }
+
+  const Bucket & bucket = bucketIt->second;
+  std::vector<unsigned int> candidates;
+
+  if (narrowing)
+  {
+    candidates.swap(result.m_matches);
+  }
+  else if (searched.size() >= 3)
+  {
+    // gather posting lists for all trigrams of searched text, smallest first
+    std::vector<const std::vector<unsigned int> *> postings;
+    for (int i = 0; i + 3 <= searched.size(); i++)
+    {
+      auto it = bucket.postings.find(trigram(searched.constData() + i));
+      if (it == bucket.postings.end())
+      {
+        result.m_matches.clear();
+        return;
+      }
+      postings.push_back(&it->second);
+    }
+
+    std::sort(postings.begin(), postings.end(),
+              [](const std::vector<unsigned int> * a, const std::vector<unsigned int> * b) { return a->size() < b->size(); });
+
+    candidates = *postings[0];
+    std::vector<unsigned int> intersection;
+    for (size_t i = 1; i < postings.size() && !candidates.empty(); i++)
+    {
+      intersection.clear();
+      std::set_intersection(candidates.begin(), candidates.end(),
+                            postings[i]->begin(), postings[i]->end(),
+                            std::back_inserter(intersection));
+      candidates.swap(intersection);
+    }
+  }
+  else
+  {
+    candidates.resize(bucket.handles.size());
+    for (unsigned int i = 0; i < candidates.size(); i++)
+      candidates[i] = i;
+  }
+
+  // trigrams only tell that text may be there, check actual names
+  result.m_matches.clear();
+  for (auto position : candidates)
+  {
+    if (searched.isEmpty() || bucket.names[position].contains(searched))
+    {
+      result.m_matches.push_back(position);
+      result.m_handles.push_back(bucket.handles[position]);
+    }
+  }
+}
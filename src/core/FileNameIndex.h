@@ -0,0 +1,103 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+/*
+* FileNameIndex.h
+*
+*  Created on: 18 Oct 2026
+*  Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+*/
+
+#ifndef _FILENAMEINDEX_H_
+#define _FILENAMEINDEX_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <QByteArray>
+#include <QString>
+
+#ifdef _WIN32
+#    ifdef BUILDING_CORE_DLL
+#        define _FILENAMEINDEX_API_ __declspec(dllexport)
+#    else
+#        define _FILENAMEINDEX_API_ __declspec(dllimport)
+#    endif
+#else
+#    define _FILENAMEINDEX_API_
+#endif
+
+namespace core
+{
+  // Trigram index over lower case file names, one bucket per extension. A substring search
+  // intersects posting lists of the searched text trigrams, then checks remaining candidates.
+  // Files are identified by a handle chosen by caller (see GameFolder::searchFiles).
+  class _FILENAMEINDEX_API_ FileNameIndex
+  {
+    public:
+      // result of a search, to be given back to next search : if searched text only grows
+      // (user typing), previous matches are narrowed instead of searching whole index again
+      class Result
+      {
+        public:
+          Result() : m_generation(0) {}
+
+          const std::vector<unsigned int> & handles() const { return m_handles; }
+
+        private:
+          friend class FileNameIndex;
+
+          std::string m_extension;
+          QByteArray m_text;
+          std::vector<unsigned int> m_matches; // positions in extension bucket
+          std::vector<unsigned int> m_handles;
+          unsigned int m_generation;
+      };
+
+      FileNameIndex();
+
+      // name must be lower case. Its data is not copied if it comes from QByteArray::fromRawData,
+      // so it must then stay valid as long as it is indexed
+      void add(const QByteArray & name, unsigned int handle);
+      void clear();
+
+      bool empty() const { return m_buckets.empty(); }
+
+      // files with given extension whose name contains text (both case insensitive)
+      void search(Result & result, const QString & text, const QString & extension) const;
+
+    private:
+      struct Bucket
+      {
+        std::vector<unsigned int> handles;
+        std::vector<QByteArray> names;
+        std::unordered_map<unsigned int, std::vector<unsigned int> > postings; // trigram => sorted file positions
+      };
+
+      static unsigned int trigram(const char * c)
+      {
+        return (unsigned char)c[0] | ((unsigned char)c[1] << 8) | ((unsigned char)c[2] << 16);
+      }
+
+      std::unordered_map<std::string, Bucket> m_buckets;
+      unsigned int m_generation; // changes each time index content changes, to invalidate results
+  };
+}
+
+#endif /* _FILENAMEINDEX_H_ */
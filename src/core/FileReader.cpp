@@ -0,0 +1,111 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+/*
+* FileReader.cpp
+*
+*  Created on: 18 Oct 2026
+*  Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+*/
+
+#include "FileReader.h"
+
+#include <cstring> // memcpy
+
+#include "logger/Logger.h"
+
+core::FileReader::FileReader()
+  : m_buffer(0), m_size(0), m_pointer(0), m_eof(true), m_curChunk(0)
+{
+}
+
+core::FileReader::FileReader(FileDataPtr data)
+  : m_data(data), m_buffer(0), m_size(0), m_pointer(0), m_eof(true), m_curChunk(0)
+{
+  if (m_data)
+  {
+    m_buffer = m_data->data();
+    m_size = m_data->size();
+    m_eof = (m_size == 0);
+  }
+}
+
+size_t core::FileReader::read(void * dest, size_t bytes)
+{
+  if (m_eof)
+    return 0;
+
+  size_t rpos = m_pointer + bytes;
+  if (rpos > m_size)
+  {
+    bytes = m_size - m_pointer;
+    m_eof = true;
+  }
+
+  memcpy(dest, m_buffer + m_pointer, bytes);
+
+  m_pointer = (unsigned int)rpos;
+
+  return bytes;
+}
+
+void core::FileReader::seek(size_t offset)
+{
+  m_pointer = (unsigned int)offset;
+  m_eof = (m_pointer >= m_size);
+}
+
+void core::FileReader::seekRelative(size_t offset)
+{
+  m_pointer += (unsigned int)offset;
+  m_eof = (m_pointer >= m_size);
+}
+
+bool core::FileReader::setChunk(unsigned int chunkName, bool resetToStart)
+{
+  if (!m_data)
+    return false;
+
+  const ChunkDirectory::Chunk * chunk = m_data->chunks().find(chunkName);
+
+  if (!chunk)
+  {
+    LOG_ERROR << __FUNCTION__ << "Cannot find chunk" << fourccName(chunkName).c_str();
+    return false;
+  }
+
+  // save current position if a chunk is currently under reading
+  if (m_curChunk != 0)
+    m_chunkPositions[m_curChunk] = m_pointer;
+
+  m_buffer = m_data->data() + chunk->start;
+  m_size = chunk->size;
+  m_pointer = 0;
+
+  if (!resetToStart)
+  {
+    auto it = m_chunkPositions.find(chunkName);
+    if (it != m_chunkPositions.end())
+      m_pointer = it->second;
+  }
+
+  m_eof = (m_pointer >= m_size);
+  m_curChunk = chunkName;
+
+  return true;
+}
@@ -0,0 +1,96 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+/*
+* FileReader.h
+*
+*  Created on: 18 Oct 2026
+*  Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+*/
+
+#ifndef _FILEREADER_H_
+#define _FILEREADER_H_
+
+#include <cstddef>
+#include <map>
+
+#include "ChunkDirectory.h"
+#include "ChunkView.h"
+#include "FileData.h"
+
+#ifdef _WIN32
+#    ifdef BUILDING_CORE_DLL
+#        define _FILEREADER_API_ __declspec(dllexport)
+#    else
+#        define _FILEREADER_API_ __declspec(dllimport)
+#    endif
+#else
+#    define _FILEREADER_API_
+#endif
+
+namespace core
+{
+  // Read cursor over shared file content (see GameFile::reader()). Each reader has its own
+  // position and current chunk, so that several threads can parse the same file at once.
+  // Content stays alive as long as a reader (or a copy of it) references it.
+  class _FILEREADER_API_ FileReader
+  {
+    public:
+      FileReader();
+      explicit FileReader(FileDataPtr data);
+
+      bool isValid() const { return m_data != 0; }
+      FileDataPtr data() const { return m_data; }
+
+      size_t read(void * dest, size_t bytes);
+      void seek(size_t offset);
+      void seekRelative(size_t offset);
+
+      size_t getSize() const { return m_size; }
+      size_t getPos() const { return m_pointer; }
+      bool isEof() const { return m_eof; }
+      const unsigned char * getBuffer() const { return m_buffer; }
+      const unsigned char * getPointer() const { return m_buffer + m_pointer; }
+
+      bool isChunked() const { return m_data && !m_data->chunks().empty(); }
+      bool hasChunk(unsigned int chunkName) const { return m_data && m_data->chunks().contains(chunkName); }
+      bool setChunk(unsigned int chunkName, bool resetToStart = true);
+
+      // typed view over whole chunk content, see GameFile::chunk
+      template <class T>
+      ChunkView<T> chunk(unsigned int chunkName) const
+      {
+        const ChunkDirectory::Chunk * c = m_data ? m_data->chunks().find(chunkName) : 0;
+        if (!c)
+          return ChunkView<T>();
+
+        return ChunkView<T>(m_data->data() + c->start, c->size);
+      }
+
+    private:
+      FileDataPtr m_data;
+      const unsigned char * m_buffer; // whole content, or current chunk
+      unsigned int m_size;
+      unsigned int m_pointer;
+      bool m_eof;
+      unsigned int m_curChunk;
+      std::map<unsigned int, unsigned int> m_chunkPositions; // saved positions when leaving a chunk
+  };
+}
+
+#endif /* _FILEREADER_H_ */
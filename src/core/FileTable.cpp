@@ -0,0 +1,171 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+/*
+* FileTable.cpp
+*
+*  Created on: 18 Oct 2026
+*  Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+*/
+
+#include "FileTable.h"
+
+#include <algorithm>
+#include <cstring> // memcmp
+
+#include <QHash>
+
+core::FileTable::FileTable()
+{
+  m_offsets.push_back(0);
+}
+
+void core::FileTable::reserve(unsigned int count, unsigned int pathsSize)
+{
+  m_arena.reserve(pathsSize);
+  m_offsets.reserve(count + 1);
+  m_ids.reserve(count);
+}
+
+void core::FileTable::add(const char * path, unsigned int size, int id)
+{
+  m_arena.insert(m_arena.end(), path, path + size);
+  m_offsets.push_back((unsigned int)m_arena.size());
+  m_ids.push_back(id);
+}
+
+void core::FileTable::buildIndexes()
+{
+  unsigned int count = size();
+
+  m_byPath.resize(count);
+  m_byId.resize(count);
+  m_byBaseName.resize(count);
+
+  for (unsigned int i = 0; i < count; i++)
+  {
+    m_byPath[i] = i;
+    m_byId[i] = std::make_pair(m_ids[i], i);
+    m_byBaseName[i] = std::make_pair(qHash(baseName(i)), i);
+  }
+
+  std::sort(m_byPath.begin(), m_byPath.end(), [this](unsigned int a, unsigned int b)
+  {
+    return comparePath(a, pathData(b), pathSize(b)) < 0;
+  });
+  std::sort(m_byId.begin(), m_byId.end());
+  std::sort(m_byBaseName.begin(), m_byBaseName.end());
+}
+
+void core::FileTable::clear()
+{
+  m_arena.clear();
+  m_offsets.assign(1, 0);
+  m_ids.clear();
+  m_byPath.clear();
+  m_byId.clear();
+  m_byBaseName.clear();
+}
+
+QByteArray core::FileTable::path(unsigned int entry) const
+{
+  return QByteArray::fromRawData(pathData(entry), pathSize(entry));
+}
+
+QByteArray core::FileTable::baseName(unsigned int entry) const
+{
+  unsigned int offset = baseNameOffset(entry);
+  return QByteArray::fromRawData(pathData(entry) + offset, pathSize(entry) - offset);
+}
+
+unsigned int core::FileTable::baseNameOffset(unsigned int entry) const
+{
+  const char * begin = pathData(entry);
+  const char * c = begin + pathSize(entry);
+
+  while (c > begin && c[-1] != '/')
+    c--;
+
+  return (unsigned int)(c - begin);
+}
+
+int core::FileTable::comparePath(unsigned int entry, const char * path, unsigned int size) const
+{
+  unsigned int entrySize = pathSize(entry);
+  int result = memcmp(pathData(entry), path, std::min(entrySize, size));
+
+  if (result != 0)
+    return result;
+
+  return (entrySize < size) ? -1 : ((entrySize > size) ? 1 : 0);
+}
+
+unsigned int core::FileTable::find(const QByteArray & path) const
+{
+  auto it = std::lower_bound(m_byPath.begin(), m_byPath.end(), path, [this](unsigned int entry, const QByteArray & path)
+  {
+    return comparePath(entry, path.constData(), path.size()) < 0;
+  });
+
+  if (it != m_byPath.end() && comparePath(*it, path.constData(), path.size()) == 0)
+    return *it;
+
+  return npos;
+}
+
+unsigned int core::FileTable::findById(int id) const
+{
+  auto it = std::lower_bound(m_byId.begin(), m_byId.end(), std::make_pair(id, 0u));
+
+  if (it != m_byId.end() && it->first == id)
+    return it->second;
+
+  return npos;
+}
+
+unsigned int core::FileTable::findByBaseName(const QByteArray & name) const
+{
+  unsigned int hash = qHash(name);
+
+  for (auto it = std::lower_bound(m_byBaseName.begin(), m_byBaseName.end(), std::make_pair(hash, 0u));
+       it != m_byBaseName.end() && it->first == hash;
+       ++it)
+  {
+    if (baseName(it->second) == name)
+      return it->second;
+  }
+
+  return npos;
+}
+
+void core::FileTable::findByPrefix(const QByteArray & prefix, std::vector<unsigned int> & entries) const
+{
+  // all paths starting with prefix are stored consecutively in path index, starting from lower_bound
+  auto it = std::lower_bound(m_byPath.begin(), m_byPath.end(), prefix, [this](unsigned int entry, const QByteArray & prefix)
+  {
+    return comparePath(entry, prefix.constData(), prefix.size()) < 0;
+  });
+
+  for (; it != m_byPath.end(); ++it)
+  {
+    if (pathSize(*it) < (unsigned int)prefix.size() || memcmp(pathData(*it), prefix.constData(), prefix.size()) != 0)
+      break;
+
+    entries.push_back(*it);
+  }
+}
@@ -0,0 +1,99 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+/*
+* FileTable.h
+*
+*  Created on: 18 Oct 2026
+*  Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+*/
+
+#ifndef _FILETABLE_H_
+#define _FILETABLE_H_
+
+#include <utility>
+#include <vector>
+
+#include <QByteArray>
+
+#ifdef _WIN32
+#    ifdef BUILDING_CORE_DLL
+#        define _FILETABLE_API_ __declspec(dllexport)
+#    else
+#        define _FILETABLE_API_ __declspec(dllimport)
+#    endif
+#else
+#    define _FILETABLE_API_
+#endif
+
+namespace core
+{
+  // Compact table of all files known by a game folder (typically whole listfile).
+  // Paths are stored back to back in a single arena, other attributes in parallel
+  // arrays, and lookups go through sorted indexes. No GameFile object is involved,
+  // they are only created by GameFolder when a file is actually asked for.
+  class _FILETABLE_API_ FileTable
+  {
+    public:
+      static const unsigned int npos = (unsigned int)-1;
+
+      FileTable();
+
+      void reserve(unsigned int count, unsigned int pathsSize);
+
+      // path must already be normalized (lower case, '/' separated, see GameFolder::normalizedPath)
+      void add(const char * path, unsigned int size, int id);
+      void add(const QByteArray & path, int id) { add(path.constData(), path.size(), id); }
+
+      // sort lookup indexes, to be called once all files are added and before any lookup
+      void buildIndexes();
+      void clear();
+
+      unsigned int size() const { return (unsigned int)m_ids.size(); }
+
+      // returned arrays point into table arena, they are valid until table is modified
+      QByteArray path(unsigned int entry) const;
+      QByteArray baseName(unsigned int entry) const;
+      int id(unsigned int entry) const { return m_ids[entry]; }
+
+      // all lookups return npos if nothing is found
+      unsigned int find(const QByteArray & path) const;
+      unsigned int findById(int id) const;
+      unsigned int findByBaseName(const QByteArray & name) const; // any of matching files if several
+
+      // entries whose path starts with prefix, sorted by path
+      void findByPrefix(const QByteArray & prefix, std::vector<unsigned int> & entries) const;
+
+    private:
+      const char * pathData(unsigned int entry) const { return m_arena.data() + m_offsets[entry]; }
+      unsigned int pathSize(unsigned int entry) const { return m_offsets[entry + 1] - m_offsets[entry]; }
+      unsigned int baseNameOffset(unsigned int entry) const;
+
+      int comparePath(unsigned int entry, const char * path, unsigned int size) const;
+
+      std::vector<char> m_arena;
+      std::vector<unsigned int> m_offsets; // path start in arena for each entry, plus arena end
+      std::vector<int> m_ids;
+
+      std::vector<unsigned int> m_byPath; // entries sorted by path
+      std::vector<std::pair<int, unsigned int> > m_byId; // (id, entry) sorted by id
+      std::vector<std::pair<unsigned int, unsigned int> > m_byBaseName; // (base name hash, entry) sorted by hash
+  };
+}
+
+#endif /* _FILETABLE_H_ */
@@ -9,16 +9,247 @@
 
 #include "DBFile.h"
 #include "CSVFile.h"
+#include "ColumnTable.h"
 
 #include <QDomDocument>
 #include <QDomElement>
 #include <QDomNamedNodeMap>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QStandardPaths>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+#include <algorithm>
+#include <deque>
 
 #include "logger/Logger.h"
 
+#define SNAPSHOT_TABLE "wmv_snapshot"
+
+namespace
+{
+  // typed values of consecutive records of a table, decoded by a worker thread
+  class RowBatch : public DBRecordWriter
+  {
+    public:
+      explicit RowBatch(const core::TableStructure * t)
+        : table(t), last(false), failed(false), decodeTime(0)
+      {}
+
+      void beginRecord(unsigned int) { m_rowStarts.push_back((unsigned int)m_values.size()); }
+      unsigned int nbRows() const { return (unsigned int)m_rowStarts.size(); }
+
+      void writeInt(qint64 value) { Value v; v.type = Value::INT_VALUE; v.intValue = value; m_values.push_back(v); }
+      void writeReal(double value) { Value v; v.type = Value::REAL_VALUE; v.realValue = value; m_values.push_back(v); }
+      void writeText(const char * value, int size)
+      {
+        Value v;
+        v.type = Value::TEXT_VALUE;
+        v.intValue = m_texts.size();
+        v.size = size;
+        m_values.push_back(v);
+        m_texts.append(value, size);
+      }
+
+      void bind(sqlite3_stmt * statement, unsigned int row) const
+      {
+        unsigned int end = (row + 1 < nbRows()) ? m_rowStarts[row + 1] : (unsigned int)m_values.size();
+        int column = 0;
+
+        for (unsigned int i = m_rowStarts[row]; i < end; i++)
+        {
+          const Value & v = m_values[i];
+          if (v.type == Value::INT_VALUE)
+            sqlite3_bind_int64(statement, ++column, v.intValue);
+          else if (v.type == Value::REAL_VALUE)
+            sqlite3_bind_double(statement, ++column, v.realValue);
+          else
+            sqlite3_bind_text(statement, ++column, m_texts.data() + v.intValue, v.size, SQLITE_STATIC);
+        }
+      }
+
+      const core::TableStructure * table;
+      bool last; // last batch for its table
+      bool failed; // table file couldn't be opened
+      qint64 decodeTime; // ms spent decoding records of this batch
+
+    private:
+      struct Value
+      {
+        enum { INT_VALUE, REAL_VALUE, TEXT_VALUE } type;
+        int size; // for text
+        union
+        {
+          qint64 intValue; // offset in m_texts for text
+          double realValue;
+        };
+      };
+
+      std::vector<unsigned int> m_rowStarts;
+      std::vector<Value> m_values;
+      std::string m_texts;
+  };
+
+  // batches waiting to be inserted. Full queue blocks decoding threads, so that
+  // decoded data never piles up in memory when writing is the bottleneck
+  class BatchQueue
+  {
+    public:
+      BatchQueue(unsigned int capacity, unsigned int nbProducers)
+        : m_capacity(capacity), m_nbProducers(nbProducers)
+      {}
+
+      void push(RowBatch * batch)
+      {
+        QMutexLocker locker(&m_mutex);
+        while (m_batches.size() >= m_capacity)
+          m_notFull.wait(&m_mutex);
+
+        m_batches.push_back(batch);
+        m_notEmpty.wakeOne();
+      }
+
+      // next batch, waiting for one if needed. Returns 0 once all producers are done and queue is empty
+      RowBatch * pop()
+      {
+        QMutexLocker locker(&m_mutex);
+        while (m_batches.empty() && m_nbProducers > 0)
+          m_notEmpty.wait(&m_mutex);
+
+        if (m_batches.empty())
+          return 0;
+
+        RowBatch * result = m_batches.front();
+        m_batches.pop_front();
+        m_notFull.wakeOne();
+        return result;
+      }
+
+      void producerDone()
+      {
+        QMutexLocker locker(&m_mutex);
+        m_nbProducers--;
+        m_notEmpty.wakeAll();
+      }
+
+    private:
+      QMutex m_mutex;
+      QWaitCondition m_notEmpty;
+      QWaitCondition m_notFull;
+      std::deque<RowBatch *> m_batches;
+      unsigned int m_capacity;
+      unsigned int m_nbProducers;
+  };
+
+  // open and decode a whole table file into batches
+  class DecodeTask : public QRunnable
+  {
+    public:
+      DecodeTask(core::TableStructure * table, BatchQueue & queue)
+        : m_table(table), m_queue(queue)
+      {}
+
+      void run()
+      {
+        QElapsedTimer timer;
+        timer.start();
+
+        DBFile * dbc = m_table->createDBFile();
+        RowBatch * batch = new RowBatch(m_table);
+
+        if (!dbc || !dbc->open())
+        {
+          batch->failed = true;
+        }
+        else
+        {
+          unsigned int nbRecord = (unsigned int)dbc->getRecordCount();
+
+          for (unsigned int begin = 0; begin < nbRecord; begin += BATCH_SIZE)
+          {
+            dbc->decodeRange(begin, std::min(begin + BATCH_SIZE, nbRecord), m_table, *batch);
+
+            if (batch->nbRows() == BATCH_SIZE)
+            {
+              batch->decodeTime = timer.elapsed();
+              m_queue.push(batch);
+              batch = new RowBatch(m_table);
+              timer.restart();
+            }
+          }
+        }
+
+        delete dbc;
+
+        batch->last = true;
+        batch->decodeTime = timer.elapsed();
+        m_queue.push(batch);
+        m_queue.producerDone();
+      }
+
+    private:
+      static const unsigned int BATCH_SIZE = 2048;
+
+      core::TableStructure * m_table;
+      BatchQueue & m_queue;
+  };
+
+  // decode a table into its in memory copy
+  class ColumnTask : public QRunnable
+  {
+    public:
+      ColumnTask(core::TableStructure * table, core::ColumnTable * columns)
+        : table(table), columns(columns), result(false)
+      {
+        setAutoDelete(false);
+      }
+
+      void run()
+      {
+        DBFile * dbc = table->createDBFile();
+
+        if (dbc && dbc->open())
+          result = columns->fill(dbc);
+
+        delete dbc;
+      }
+
+      core::TableStructure * table;
+      core::ColumnTable * columns;
+      bool result;
+  };
+
+  // insert progress of a table, on writer side
+  struct TableFill
+  {
+    TableFill() : statement(0), nbRecords(0), decodeTime(0), insertTime(0), failed(false) {}
+
+    sqlite3_stmt * statement;
+    unsigned int nbRecords;
+    qint64 decodeTime;
+    qint64 insertTime;
+    bool failed;
+  };
+}
+
 core::GameDatabase::~GameDatabase()
 {
+  m_statementCache.clear();
+
+  for (auto it : m_columnTables)
+    delete it.second;
+
+  // kept until then, column tables are built from them
+  for (auto it : m_dbStruct)
+    delete it;
+
   if(m_db)
     sqlite3_close(m_db);
 }
@@ -32,70 +263,256 @@ core::GameDatabase::GameDatabase()
 
 bool core::GameDatabase::initFromXML(const QString & file)
 {
-   int rc = 1;
-
-   if(m_fastMode)
-	  rc = sqlite3_open("./wowdb.sqlite", &m_db);
-   else
-	  rc = sqlite3_open(":memory:", &m_db);
-
-   if( rc )
-   {
-     LOG_INFO << "Can't open database:" << sqlite3_errmsg(m_db);
-     return false;
-   }
-   else
-   {
-     LOG_INFO << "Opened database successfully";
-   }
-
-   sqlite3_profile(m_db, GameDatabase::logQueryTime, m_db);
-   return createDatabaseFromXML(core::Game::instance().configFolder() + file);
+  QString xmlFile = core::Game::instance().configFolder() + file;
+
+  // snapshot goes to per user data folder, install folder (holding xml file) may be read only
+  QString snapshotFolder = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+  if (snapshotFolder.isEmpty() || !QDir().mkpath(snapshotFolder))
+  {
+    LOG_ERROR << "No writable user data folder, database snapshot is saved in" << core::Game::instance().configFolder();
+    snapshotFolder = core::Game::instance().configFolder();
+  }
+  else
+  {
+    snapshotFolder += "/";
+  }
+
+  m_snapshotFile = snapshotFolder + QFileInfo(file).completeBaseName() + ".sqlite";
+
+  QByteArray key = snapshotKey(xmlFile);
+  bool snapshotValid = isSnapshotValid(key);
+
+  int rc = 1;
+
+  if (m_fastMode)
+  {
+    // work directly on snapshot file, nothing to load at all if it is up to date
+    if (!snapshotValid)
+      QFile::remove(m_snapshotFile);
+    rc = sqlite3_open(m_snapshotFile.toUtf8().constData(), &m_db);
+  }
+  else
+  {
+    rc = sqlite3_open(":memory:", &m_db);
+  }
+
+  if( rc )
+  {
+    LOG_INFO << "Can't open database:" << sqlite3_errmsg(m_db);
+    return false;
+  }
+  else
+  {
+    LOG_INFO << "Opened database successfully";
+  }
+
+  sqlite3_profile(m_db, GameDatabase::logQueryTime, m_db);
+
+  if (snapshotValid && (m_fastMode || copyDatabase(m_snapshotFile, false)))
+  {
+    LOG_INFO << "Database loaded from snapshot" << m_snapshotFile;
+
+    // sql tables are ready, in memory ones are copied from them
+    if (readStructureFromXML(xmlFile))
+      buildColumnTables(true);
+
+    return true;
+  }
+
+  if (!createDatabaseFromXML(xmlFile))
+    return false;
+
+  // key is written last : a snapshot interrupted while being built is never seen as valid
+  sqlQuery("CREATE TABLE " SNAPSHOT_TABLE " (key TEXT)");
+  sqlQuery(QString("INSERT INTO " SNAPSHOT_TABLE " VALUES('%1')").arg(QString::fromUtf8(key)));
+
+  if (!m_fastMode)
+  {
+    if (copyDatabase(m_snapshotFile, true))
+      LOG_INFO << "Database snapshot saved to" << m_snapshotFile;
+    else
+      LOG_ERROR << "Fail to save database snapshot to" << m_snapshotFile;
+  }
+
+  buildColumnTables(false);
+
+  return true;
+}
+
+bool core::GameDatabase::invalidateSnapshot()
+{
+  if (m_snapshotFile.isEmpty())
+    return false;
+
+  LOG_INFO << "Invalidating database snapshot" << m_snapshotFile;
+
+  // snapshot is in use in fast mode, simply drop its key
+  if (m_fastMode)
+    return sqlQuery("DELETE FROM " SNAPSHOT_TABLE).valid;
+
+  return QFile::remove(m_snapshotFile) || !QFile::exists(m_snapshotFile);
 }
 
-sqlResult core::GameDatabase::sqlQuery(const QString & query)
+QByteArray core::GameDatabase::snapshotKey(const QString & xmlFile)
 {
-  sqlResult result;
+  // layout hashes of tables are part of xml content
+  QCryptographicHash hash(QCryptographicHash::Md5);
+  QFile f(xmlFile);
+  if (f.open(QIODevice::ReadOnly))
+    hash.addData(&f);
+
+  return QString("%1|%2|%3").arg(GAMEDIRECTORY.version())
+                            .arg(GAMEDIRECTORY.locale())
+                            .arg(QString::fromLatin1(hash.result().toHex())).toUtf8();
+}
+
+bool core::GameDatabase::isSnapshotValid(const QByteArray & key)
+{
+  if (!QFile::exists(m_snapshotFile))
+    return false;
 
-  char *zErrMsg = 0;
-  int rc = sqlite3_exec(m_db, query.toStdString().c_str(), core::GameDatabase::treatQuery, (void *)&result, &zErrMsg);
-  if( rc != SQLITE_OK )
+  sqlite3 * db = 0;
+  bool result = false;
+
+  if (sqlite3_open_v2(m_snapshotFile.toUtf8().constData(), &db, SQLITE_OPEN_READONLY, 0) == SQLITE_OK)
   {
-    LOG_ERROR << "Querying in database" << query;
-    LOG_ERROR << "SQL error:" << zErrMsg;
-    sqlite3_free(zErrMsg);
-    result.valid = false;
+    sqlite3_stmt * statement = 0;
+    if (sqlite3_prepare_v2(db, "SELECT key FROM " SNAPSHOT_TABLE, -1, &statement, 0) == SQLITE_OK &&
+        sqlite3_step(statement) == SQLITE_ROW)
+    {
+      const char * snapshotKey = reinterpret_cast<const char *>(sqlite3_column_text(statement, 0));
+      result = (snapshotKey && key == snapshotKey);
+    }
+    sqlite3_finalize(statement);
   }
-  else
+
+  sqlite3_close(db);
+
+  if (!result)
+    LOG_INFO << "Database snapshot" << m_snapshotFile << "is outdated, database will be rebuilt";
+
+  return result;
+}
+
+bool core::GameDatabase::copyDatabase(const QString & file, bool toFile)
+{
+  // when saving, write in a temporary file first, so that a valid snapshot is never partially overwritten
+  QString path = toFile ? file + ".tmp" : file;
+
+  sqlite3 * db = 0;
+  int flags = toFile ? (SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE) : SQLITE_OPEN_READONLY;
+  if (sqlite3_open_v2(path.toUtf8().constData(), &db, flags, 0) != SQLITE_OK)
+  {
+    sqlite3_close(db);
+    return false;
+  }
+
+  sqlite3_backup * backup = toFile ? sqlite3_backup_init(db, "main", m_db, "main")
+                                   : sqlite3_backup_init(m_db, "main", db, "main");
+  bool result = false;
+  if (backup)
   {
-    result.valid = true; // result is valid
+    result = (sqlite3_backup_step(backup, -1) == SQLITE_DONE);
+    sqlite3_backup_finish(backup);
+  }
+
+  sqlite3_close(db);
+
+  if (toFile)
+  {
+    if (result)
+    {
+      QFile::remove(file);
+      result = QFile::rename(path, file);
+    }
+    else
+    {
+      QFile::remove(path);
+    }
   }
 
   return result;
 }
 
-void core::GameDatabase::addTable(TableStructure * tbl)
+core::SqlQuery core::GameDatabase::prepare(const QString & query)
 {
-  m_dbStruct.push_back(tbl);
+  return SqlQuery(m_db, query, profiler());
 }
 
-int core::GameDatabase::treatQuery(void *resultPtr, int nbcols, char ** vals , char ** cols)
+core::SqlQuery core::GameDatabase::cachedQuery(const QString & queryTemplate)
 {
-  sqlResult * r = (sqlResult *)resultPtr;
-  if(!r)
-    return 1;
+  return SqlQuery(m_db, &m_statementCache, queryTemplate, profiler());
+}
+
+sqlResult core::GameDatabase::sqlQuery(const QString & query)
+{
+  SqlQuery q(m_db, query, profiler());
+  return sqlQuery(q);
+}
 
-  std::vector<QString> values;
-  // update columns
-  for(int i=0; i<nbcols; i++)
+sqlResult core::GameDatabase::sqlQuery(const QString & queryTemplate, const QVariantList & parameters)
+{
+  SqlQuery q = cachedQuery(queryTemplate);
+
+  for (int i = 0; i < parameters.size(); i++)
+    q.bind(i + 1, parameters[i]);
+
+  return sqlQuery(q);
+}
+
+sqlResult core::GameDatabase::sqlQuery(SqlQuery & q)
+{
+  sqlResult result;
+
+  // rows are copied as strings, use prepare() or cachedQuery() to read them typed instead
+  while (q.next())
   {
-    values.push_back(QString(vals[i]));
+    int nbcols = q.columnCount();
+    std::vector<QString> values;
+    values.reserve(nbcols);
+
+    for (int i = 0; i < nbcols; i++)
+      values.push_back(q.text(i));
+
+    result.values.push_back(values);
+    result.nbcols = nbcols;
   }
 
-  r->values.push_back(values);
-  r->nbcols = nbcols;
+  result.valid = q.isValid() && !q.hasError();
 
-  return 0;
+  return result;
+}
+
+core::QueryProfiler * core::GameDatabase::profiler()
+{
+  return QueryProfiler::isEnabled() ? &m_queryProfiler : 0;
+}
+
+sqlite3_stmt * core::GameDatabase::prepareInsert(const TableStructure * table)
+{
+  QStringList columns = table->columnNames();
+  QStringList parameters;
+  for (int i = 0; i < columns.size(); i++)
+    parameters << "?";
+
+  QString query = QString("INSERT INTO %1(%2) VALUES(%3)").arg(table->name)
+                                                            .arg(columns.join(","))
+                                                            .arg(parameters.join(","));
+
+  sqlite3_stmt * statement = 0;
+  if (sqlite3_prepare_v2(m_db, query.toStdString().c_str(), -1, &statement, 0) != SQLITE_OK)
+  {
+    LOG_ERROR << "Preparing" << query;
+    LOG_ERROR << "SQL error:" << sqlite3_errmsg(m_db);
+    return 0;
+  }
+
+  return statement;
+}
+
+void core::GameDatabase::addTable(TableStructure * tbl)
+{
+  m_dbStruct.push_back(tbl);
 }
 
 bool core::GameDatabase::createDatabaseFromXML(const QString & file)
@@ -108,15 +525,21 @@ bool core::GameDatabase::createDatabaseFromXML(const QString & file)
 
   bool result = true; // ok until we found an issue
 
+  // no journal while filling : if building is interrupted, snapshot key (written last, see initFromXML)
+  // is missing and database is built again from scratch on next startup
+  sqlQuery("PRAGMA journal_mode = OFF");
+  sqlQuery("PRAGMA synchronous = OFF");
+  sqlQuery("PRAGMA temp_store = MEMORY");
+
+  QElapsedTimer timer;
+  timer.start();
+
+  std::vector<TableStructure *> tables;
   for (auto it = m_dbStruct.begin(), itEnd = m_dbStruct.end(); it != itEnd; ++it)
   {
     if ((*it)->create())
     {
-      if (!(*it)->fill())
-      {
-        LOG_ERROR << "Error during table filling" << (*it)->name;
-        result = false;
-      }
+      tables.push_back(*it);
     }
     else
     {
@@ -125,12 +548,257 @@ bool core::GameDatabase::createDatabaseFromXML(const QString & file)
     }
   }
 
-  for (auto it : m_dbStruct)
-    delete it;
+  if (!fillTables(tables))
+    result = false;
+
+  // with query profiling enabled, lookups on index keys are timed without indexes, to be
+  // compared with same lookups once indexes exist
+  QueryProfiler probesBefore;
+  if (QueryProfiler::isEnabled())
+    runIndexProbes(tables, probesBefore);
+
+  // indexes are built once tables are filled, rather than updated at each insert
+  QElapsedTimer indexTimer;
+  indexTimer.start();
+
+  for (auto it : tables)
+  {
+    if (!it->createIndexes())
+      LOG_ERROR << "Error during index creation" << it->name;
+  }
+
+  LOG_INFO << "Indexes created in" << indexTimer.elapsed() << "ms";
+
+  if (QueryProfiler::isEnabled())
+  {
+    QueryProfiler probesAfter;
+    runIndexProbes(tables, probesAfter);
+    logIndexProbes(probesBefore, probesAfter);
+  }
+
+  LOG_INFO << "Database created in" << timer.elapsed() << "ms (" << m_dbStruct.size() << "tables)";
+
+  // later writes (snapshot key, invalidation in fast mode) are journaled again
+  sqlQuery("PRAGMA synchronous = NORMAL");
+  sqlQuery("PRAGMA journal_mode = DELETE");
 
   return result; 
 }
 
+bool core::GameDatabase::fillTables(const std::vector<TableStructure *> & tables)
+{
+  // table files are opened and decoded concurrently by pool threads. Calling thread is
+  // the only one writing to database (sqlite is single writer), it inserts batches as they come
+  QThreadPool pool;
+  BatchQueue queue(pool.maxThreadCount() * 4, (unsigned int)tables.size());
+
+  for (auto it : tables)
+    pool.start(new DecodeTask(it, queue));
+
+  sqlQuery("BEGIN TRANSACTION");
+
+  bool result = true;
+  std::map<const TableStructure *, TableFill> fills;
+  qint64 totalDecodeTime = 0;
+  QElapsedTimer timer;
+  timer.start();
+
+  while (RowBatch * batch = queue.pop())
+  {
+    const TableStructure * table = batch->table;
+    TableFill & fill = fills[table];
+    fill.decodeTime += batch->decodeTime;
+    totalDecodeTime += batch->decodeTime;
+
+    if (batch->failed)
+      fill.failed = true;
+
+    if (!fill.failed && !fill.statement)
+    {
+      fill.statement = prepareInsert(table);
+      fill.failed = (fill.statement == 0);
+    }
+
+    if (!fill.failed)
+    {
+      QElapsedTimer insertTimer;
+      insertTimer.start();
+
+      for (unsigned int row = 0; row < batch->nbRows(); row++)
+      {
+        batch->bind(fill.statement, row);
+
+        if (sqlite3_step(fill.statement) != SQLITE_DONE)
+        {
+          LOG_ERROR << "Inserting record" << fill.nbRecords + row << "in table" << table->name;
+          LOG_ERROR << "SQL error:" << sqlite3_errmsg(m_db);
+          fill.failed = true;
+          break;
+        }
+
+        sqlite3_reset(fill.statement);
+        sqlite3_clear_bindings(fill.statement);
+      }
+
+      fill.nbRecords += batch->nbRows();
+      fill.insertTime += insertTimer.elapsed();
+    }
+
+    if (batch->last)
+    {
+      sqlite3_finalize(fill.statement);
+      fill.statement = 0;
+
+      if (fill.failed)
+      {
+        LOG_ERROR << "Error during table filling" << table->name;
+        result = false;
+      }
+      else
+      {
+        LOG_INFO << "table" << table->name << "successfuly filled:" << fill.nbRecords << "records (decode"
+                 << fill.decodeTime << "ms, insert" << fill.insertTime << "ms)";
+      }
+    }
+
+    delete batch;
+  }
+
+  pool.waitForDone();
+
+  sqlQuery("COMMIT");
+
+  qint64 elapsed = timer.elapsed();
+  LOG_INFO << "Tables filled in" << elapsed << "ms using" << pool.maxThreadCount() << "decoding threads ("
+           << totalDecodeTime << "ms of summed decoding time)";
+
+  return result;
+}
+
+void core::GameDatabase::runIndexProbes(const std::vector<TableStructure *> & tables, QueryProfiler & profiler)
+{
+  static const int NB_RUNS = 8;
+
+  for (auto table : tables)
+  {
+    for (auto & index : table->allIndexes())
+    {
+      // key value taken from table itself, so that lookup finds something
+      QStringList conditions;
+      bool valid = true;
+      for (auto & column : index.columns)
+      {
+        valid = valid && table->hasColumn(column);
+        conditions << QString("%1 = (SELECT %1 FROM %2 LIMIT 1)").arg(column).arg(table->name);
+      }
+
+      // already reported by TableStructure::createIndexes
+      if (!valid)
+        continue;
+
+      SqlQuery q(m_db, QString("SELECT COUNT(*) FROM %1 WHERE %2").arg(table->name).arg(conditions.join(" AND ")), &profiler);
+      for (int run = 0; run < NB_RUNS && q.isValid(); run++)
+      {
+        while (q.next())
+          ;
+        q.reset();
+      }
+    }
+  }
+}
+
+void core::GameDatabase::logIndexProbes(const QueryProfiler & before, const QueryProfiler & after)
+{
+  std::map<QString, QueryProfiler::Statistics> beforeStats = before.statistics();
+  std::map<QString, QueryProfiler::Statistics> afterStats = after.statistics();
+
+  qint64 beforeTime = 0;
+  qint64 afterTime = 0;
+
+  LOG_INFO << "Index key lookups, average time before -> after index creation:";
+
+  for (auto & it : beforeStats)
+  {
+    auto found = afterStats.find(it.first);
+    if (found == afterStats.end() || !it.second.executions || !found->second.executions)
+      continue;
+
+    const QueryProfiler::Statistics & b = it.second;
+    const QueryProfiler::Statistics & a = found->second;
+
+    LOG_INFO << it.first << ":" << b.time / b.executions / 1000 << "us ->" << a.time / a.executions / 1000
+             << "us," << b.fullScanSteps / b.executions << "->" << a.fullScanSteps / a.executions << "rows scanned";
+
+    beforeTime += b.time / b.executions;
+    afterTime += a.time / a.executions;
+  }
+
+  LOG_INFO << "Index key lookups, summed average time:" << beforeTime / 1000 << "us ->" << afterTime / 1000 << "us";
+}
+
+void core::GameDatabase::buildColumnTables(bool fromDatabase)
+{
+  QElapsedTimer timer;
+  timer.start();
+
+  QThreadPool pool;
+  std::vector<ColumnTask *> tasks;
+
+  for (auto table : m_dbStruct)
+  {
+    if (!table->columnStore || m_columnTables.find(table->name) != m_columnTables.end())
+      continue;
+
+    ColumnTable * columns = new ColumnTable(table);
+    m_columnTables[table->name] = columns;
+
+    ColumnTask * task = new ColumnTask(table, columns);
+    tasks.push_back(task);
+
+    // sql table already holds file content, read it back on calling thread (database connection
+    // isn't shared with pool threads). Game file is only decoded if this fails
+    if (fromDatabase)
+    {
+      QString query = QString("SELECT %1 FROM %2").arg(table->columnNames().join(",")).arg(table->name);
+      if (!table->withoutRowid)
+        query += " ORDER BY rowid"; // insertion order, that is file order (key order otherwise)
+
+      SqlQuery q = prepare(query);
+      task->result = columns->fill(q);
+      if (task->result)
+        continue;
+
+      LOG_ERROR << "Fail to read in memory table" << table->name << "from database, decoding it from game file";
+    }
+
+    pool.start(task);
+  }
+
+  pool.waitForDone();
+
+  for (auto task : tasks)
+  {
+    // lookups on this table will go through sql
+    if (!task->result)
+    {
+      LOG_ERROR << "Fail to load in memory table" << task->table->name;
+      m_columnTables.erase(task->table->name);
+      delete task->columns;
+    }
+    delete task;
+  }
+
+  if (!tasks.empty())
+    LOG_INFO << tasks.size() << "in memory tables loaded" << (fromDatabase ? "from database" : "from game files")
+             << "in" << timer.elapsed() << "ms";
+}
+
+const core::ColumnTable * core::GameDatabase::columnTable(const QString & name) const
+{
+  auto it = m_columnTables.find(name);
+  return (it != m_columnTables.end()) ? it->second : 0;
+}
+
 void core::GameDatabase::logQueryTime(void* aDb, const char* aQueryStr, sqlite3_uint64 aTimeInNs)
 {
   if(aTimeInNs/1000000 > 30)
@@ -171,11 +839,35 @@ bool core::GameDatabase::readStructureFromXML(const QString & file)
     else
       tblStruct->file = tblStruct->name;
 
-    readSpecificTableAttributes(child, tblStruct);
+    if (!attributes.namedItem("columnStore").isNull())
+      tblStruct->columnStore = true;
+
+    if (!attributes.namedItem("withoutRowid").isNull())
+      tblStruct->withoutRowid = true;
+
+    readSpecificTableAttributes(e, tblStruct);
 
     int fieldId = 0;
     while (!child.isNull())
     {
+      if (child.tagName() == "index")
+      {
+        QDomNamedNodeMap attributes = child.attributes();
+
+        IndexStructure index;
+        index.name = attributes.namedItem("name").nodeValue();
+        index.columns = attributes.namedItem("columns").nodeValue().split(",", QString::SkipEmptyParts);
+        index.included = attributes.namedItem("include").nodeValue().split(",", QString::SkipEmptyParts);
+
+        if (index.name.isEmpty() || index.columns.isEmpty())
+          LOG_ERROR << "Index of table" << tblStruct->name << "needs a name and columns";
+        else
+          tblStruct->indexes.push_back(index);
+
+        child = child.nextSiblingElement();
+        continue;
+      }
+
       core::FieldStructure * fieldStruct = createFieldStructure();
       fieldStruct->id = fieldId;
       QDomNamedNodeMap attributes = child.attributes();
@@ -237,7 +929,7 @@ bool core::TableStructure::create()
   LOG_INFO << "Creating table" << name;
   QString create = "CREATE TABLE " + name + " (";
 
-  std::list<QString> indexesToCreate;
+  bool hasKey = false;
 
   for (auto it = fields.begin(), itEnd = fields.end(); it != itEnd; ++it)
   {
@@ -248,7 +940,10 @@ bool core::TableStructure::create()
       create += (*it)->type;
 
       if ((*it)->isKey)
+      {
         create += " PRIMARY KEY NOT NULL";
+        hasKey = true;
+      }
 
       create += ",";
     }
@@ -263,119 +958,117 @@ bool core::TableStructure::create()
         create += ",";
       }
     }
-
-    if ((*it)->needIndex)
-      indexesToCreate.push_back((*it)->name);
   }
 
   // remove spurious "," at the end of string, if any
   if (create.lastIndexOf(",") == create.length() - 1)
     create.remove(create.length() - 1, 1);
-  create += ");";
+  create += ")";
+
+  if (withoutRowid)
+  {
+    if (hasKey)
+      create += " WITHOUT ROWID";
+    else
+      LOG_ERROR << "Table" << name << "has no primary key, it is created with rowid";
+  }
+
+  create += ";";
 
   //LOG_INFO << create;
 
   sqlResult r = core::Game::instance().database().sqlQuery(create);
 
   if (r.valid)
-  {
     LOG_INFO << "Table" << name << "successfully created";
 
-    // create indexes
-    for (auto it = indexesToCreate.begin(), itEnd = indexesToCreate.end(); it != itEnd; ++it)
-    {
-      QString query = QString("CREATE INDEX %1_%2 ON %1(%2)").arg(name).arg(*it);
-      core::Game::instance().database().sqlQuery(query);
-    }
-  }
-
   return r.valid;
 }
 
-bool core::TableStructure::fill()
+std::vector<core::IndexStructure> core::TableStructure::allIndexes() const
 {
-  LOG_INFO << "Filling table" << name << "...";
+  std::vector<IndexStructure> result;
 
-  DBFile * dbc = createDBFile();
-  if (!dbc || !dbc->open())
-    return false;
+  for (auto it : fields)
+  {
+    if (!it->needIndex)
+      continue;
+
+    IndexStructure index;
+    index.name = it->name;
+    index.columns << it->name;
+    result.push_back(index);
+  }
+
+  result.insert(result.end(), indexes.begin(), indexes.end());
 
-  QString query = "INSERT INTO ";
-  query += name;
-  query += "(";
-  int nbFields = fields.size();
-  int curfield = 0;
-  for (auto it = fields.begin(), itEnd = fields.end();
-    it != itEnd;
-    ++it, curfield++)
+  return result;
+}
+
+bool core::TableStructure::createIndexes()
+{
+  bool result = true;
+
+  for (auto & index : allIndexes())
   {
-    if ((*it)->arraySize == 1) // simple field
-    {
-      query += (*it)->name;
-    }
-    else
+    QStringList indexColumns = index.columns + index.included;
+
+    bool valid = true;
+    for (auto & column : indexColumns)
     {
-      for (unsigned int i = 1; i <= (*it)->arraySize; i++)
+      if (!hasColumn(column))
       {
-        query += (*it)->name;
-        query += QString::number(i);
-        if (i != (*it)->arraySize)
-          query += ",";
+        LOG_ERROR << "Index" << index.name << "of table" << name << "uses unknown column" << column;
+        valid = false;
       }
     }
-    if (curfield != nbFields - 1)
-      query += ",";
-  }
 
-  query += ") VALUES";
+    if (!valid)
+    {
+      result = false;
+      continue;
+    }
 
-  QString queryBase = query;
-  int record = 0;
-  int nbRecord = dbc->getRecordCount();
+    QElapsedTimer timer;
+    timer.start();
 
-  for (DBFile::Iterator it = dbc->begin(), itEnd = dbc->end(); it != itEnd; ++it, record++)
-  {
-    std::vector<std::string> fields = it.get(this);
-
-    for (int field = 0, nbfield = fields.size(); field < nbfield; field++)
+    QString query = QString("CREATE INDEX %1_%2 ON %1(%3)").arg(name).arg(index.name).arg(indexColumns.join(","));
+    if (!core::Game::instance().database().sqlQuery(query).valid)
     {
-      if (field == 0)
-        query += " (";
-      query += "\"";
-      query += QString::fromStdString(fields[field]);
-      query += "\"";
-      if (field != nbfield - 1)
-        query += ",";
-      else
-        query += ")";
+      LOG_ERROR << "Fail to create index" << index.name << "of table" << name;
+      result = false;
+      continue;
     }
-    // inserting all records at once makes the application crash, so
-    // insert in chunks of 200 lines. If it's the last record anyway
-    // then don't, as the final query after the for() loop will do it:
-    if (record % 200 == 0 && record != nbRecord - 1)
+
+    LOG_INFO << "Index" << name + "_" + index.name << "created in" << timer.elapsed() << "ms";
+  }
+
+  return result;
+}
+
+QStringList core::TableStructure::columnNames() const
+{
+  QStringList result;
+
+  for (auto it : fields)
+  {
+    if (it->arraySize == 1) // simple field
     {
-      query += ";";
-      sqlResult r = GAMEDATABASE.sqlQuery(query);
-      if (!r.valid)
-        return false;
-      query = queryBase;
+      result << it->name;
     }
     else
     {
-      if (record != nbRecord - 1)
-        query += ",";
+      for (unsigned int i = 1; i <= it->arraySize; i++)
+        result << it->name + QString::number(i);
     }
   }
 
-  query += ";";
-  sqlResult r = GAMEDATABASE.sqlQuery(query);
-
-  if (r.valid)
-    LOG_INFO << "table" << name << "successfuly filled";
-
-  delete dbc;
+  return result;
+}
 
-  return r.valid;
+bool core::TableStructure::hasColumn(const QString & column) const
+{
+  return columnNames().contains(column, Qt::CaseInsensitive);
 }
 
 DBFile * core::TableStructure::createDBFile()
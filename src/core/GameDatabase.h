@@ -12,11 +12,16 @@
 #include <vector>
 #include "sqlite3.h"
 
+#include "SqlQuery.h"
+#include "QueryProfiler.h"
+#include "StatementCache.h"
+
 class DBFile;
 class GameFile;
 
 class QDomElement;
 #include <QString>
+#include <QStringList>
 
 #ifdef _WIN32
 #    ifdef BUILDING_CORE_DLL
@@ -64,12 +69,27 @@ namespace core
     int id;
   };
 
+  // index declared by an <index name="" columns="" include=""/> element of a table
+  class _GAMEDATABASE_API_ IndexStructure
+  {
+  public:
+    QString name;
+    QStringList columns;
+    // appended to index key so that queries reading them are answered from index only
+    // (sqlite has no INCLUDE clause)
+    QStringList included;
+  };
+
+  class ColumnTable;
+
   class _GAMEDATABASE_API_ TableStructure
   {
   public:
     TableStructure() :
       name(""),
-      file("")
+      file(""),
+      columnStore(false),
+      withoutRowid(false)
     {}
 
     virtual ~TableStructure();
@@ -77,9 +97,22 @@ namespace core
     QString name;
     QString file;
     std::vector<FieldStructure *> fields;
+    // also kept in memory as a ColumnTable (columnStore="yes" in xml), for fast lookups by key
+    bool columnStore;
+    // rows stored in primary key order, without separate key index (withoutRowid="yes" in xml).
+    // Fits key-value tables only looked up by key
+    bool withoutRowid;
+    std::vector<IndexStructure> indexes;
 
     bool create();
-    bool fill();
+    // single field (createIndex="yes") and declared indexes, to be created once table is filled
+    bool createIndexes();
+    std::vector<IndexStructure> allIndexes() const;
+
+    // sql column names, array fields being expanded (name1, name2, ...)
+    QStringList columnNames() const;
+    // sql column names are case insensitive
+    bool hasColumn(const QString & column) const;
 
     virtual DBFile * createDBFile();
   };
@@ -93,10 +126,37 @@ namespace core
 
     bool initFromXML(const QString & file);
 
+    // whole result converted to strings. Prefer prepare() for large results or repeated queries
     sqlResult sqlQuery(const QString &query);
+    // prepared statement, to be run with bound parameters and read through a typed cursor
+    SqlQuery prepare(const QString & query);
+
+    // same as prepare(), but statement is taken from (and given back to) a cache keyed by query
+    // text, so that it is only parsed once. Use '?' parameters rather than formatting values
+    // into query text. Safe to call from any thread
+    SqlQuery cachedQuery(const QString & queryTemplate);
+    // cached query with given parameters bound in order, whole result converted to strings
+    sqlResult sqlQuery(const QString & queryTemplate, const QVariantList & parameters);
+    // run given query and convert its whole result to strings
+    sqlResult sqlQuery(SqlQuery & query);
+
+    const StatementCache & statementCache() const { return m_statementCache; }
 
+    // per template statistics of queries run so far, when profiling is enabled (see QueryProfiler::enable).
+    // Use logReport() / writeReport() to get report (viewer logs it on exit and saves it from File menu)
+    QueryProfiler & queryProfiler() { return m_queryProfiler; }
+
+    // in memory copy of given table, 0 if table isn't declared with columnStore="yes".
+    // Prefer it over sql for lookups by key / indexed field
+    const ColumnTable * columnTable(const QString & name) const;
+
+    // use database snapshot file directly instead of restoring it in memory
     void setFastMode() { m_fastMode = true; }
 
+    // built database is saved in per user data folder, along with a key (game build, locale, xml content),
+    // and restored on next startups as long as key doesn't change. This forces a rebuild on next startup
+    bool invalidateSnapshot();
+
     virtual ~GameDatabase();
 
     void addTable(TableStructure *);
@@ -110,17 +170,36 @@ namespace core
   protected:
 
   private:
-    static int treatQuery(void *NotUsed, int nbcols, char ** values, char ** cols);
     static void logQueryTime(void* aDb, const char* aQueryStr, sqlite3_uint64 aTimeInNs);
 
     bool createDatabaseFromXML(const QString & file);
+    bool fillTables(const std::vector<TableStructure *> & tables);
+    // lookup on key of each index of tables, timed through given profiler. Run before and after
+    // index creation when query profiling is enabled, see logIndexProbes
+    void runIndexProbes(const std::vector<TableStructure *> & tables, QueryProfiler & profiler);
+    void logIndexProbes(const QueryProfiler & before, const QueryProfiler & after);
+    // in memory copies of columnStore tables. Read back from sql tables when these are already
+    // filled (database restored from snapshot), decoded from game files otherwise
+    void buildColumnTables(bool fromDatabase);
+
+    QByteArray snapshotKey(const QString & xmlFile);
+    bool isSnapshotValid(const QByteArray & key);
+    // copy whole database to (or from) given file, using sqlite backup api
+    bool copyDatabase(const QString & file, bool toFile);
+    sqlite3_stmt * prepareInsert(const TableStructure * table);
+    // profiler given to queries, 0 when profiling is disabled
+    QueryProfiler * profiler();
     bool readStructureFromXML(const QString & file);
 
     sqlite3 *m_db;
+    StatementCache m_statementCache;
+    QueryProfiler m_queryProfiler;
 
     std::vector<TableStructure * > m_dbStruct;
+    std::map<QString, ColumnTable *> m_columnTables;
 
     bool m_fastMode;
+    QString m_snapshotFile;
   };
 
 }
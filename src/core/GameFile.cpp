@@ -8,8 +8,11 @@
 
 #include "GameFile.h"
 
+#include <algorithm> // std::min
 #include <cstring> // memcpy
 
+#include <QMutexLocker>
+
 #include "logger\Logger.h"
 
 size_t GameFile::read(void* dest, size_t bytes)
@@ -49,7 +52,37 @@ void GameFile::seekRelative(size_t offset)
 bool GameFile::open()
 {
   if (isAlreadyOpened())
+  {
+    if (!m_partial)
+      return true;
+
+    // only part of file is exposed so far (see openRange). Expose it entirely, reading
+    // it through the handle already opened if memory doesn't hold all of it
+    unsigned int fileSize = m_fileSize;
+
+    chunks.clear();
+    m_curChunk = 0;
+    m_partial = false;
+
+    if (m_contentOffset == 0 && m_contentSize == fileSize)
+    {
+      buffer = originalBuffer;
+      size = fileSize;
+      eof = (size == 0);
+    }
+    else
+    {
+      allocate(fileSize);
+      m_contentOffset = 0;
+      m_contentSize = fileSize;
+      eof = (readFile() == 0);
+    }
+
+    pointer = 0;
+    doPostOpenOperation();
+
     return true;
+  }
 
   eof = true;
 
@@ -58,35 +91,108 @@ bool GameFile::open()
 
   if (getFileSize(size))
   {
-    allocate(size);
+    m_fileSize = size;
+
+    // file content may already be exposed by inherited class, see setExternalBuffer / setSharedBuffer
+    if (!originalBuffer)
+      allocate(size);
 
     if (readFile() != 0)
       eof = false;
 
+    m_contentOffset = 0;
+    m_contentSize = size;
+
     doPostOpenOperation();
   }
 
   return true;
 }
 
+bool GameFile::openRange(unsigned int offset, unsigned int length)
+{
+  if (!isAlreadyOpened())
+  {
+    eof = true;
+
+    if (!openFile())
+      return false;
+
+    // whole file size is kept : storage may not be able to give it anymore once content is read
+    if (!getFileSize(m_fileSize))
+      return true;
+
+    // file content may already be exposed by inherited class, see setExternalBuffer / setSharedBuffer
+    if (originalBuffer)
+    {
+      m_contentOffset = 0;
+      m_contentSize = (readFile() == 0) ? 0 : m_fileSize;
+    }
+  }
+
+  unsigned int fileSize = m_fileSize;
+
+  if (offset > fileSize)
+    offset = fileSize;
+
+  if (length > fileSize - offset)
+    length = fileSize - offset;
+
+  // memory doesn't hold requested range yet, read it through opened handle
+  if (offset < m_contentOffset || offset + length > m_contentOffset + m_contentSize)
+    loadRange(offset, length, fileSize);
+
+  unsigned int start = offset - m_contentOffset;
+
+  buffer = originalBuffer + start;
+  pointer = 0;
+  size = (m_contentSize > start) ? std::min(length, m_contentSize - start) : 0;
+  eof = (size == 0);
+  m_curChunk = 0;
+  m_partial = true;
+
+  return true;
+}
+
+void GameFile::loadRange(unsigned int offset, unsigned int length, unsigned int fileSize)
+{
+  allocate(length);
+
+  unsigned long read = 0;
+  if (readFileRange(offset, read))
+  {
+    m_contentOffset = offset;
+    m_contentSize = read;
+    return;
+  }
+
+  // storage can't read partially (or partial read failed), get whole file
+  allocate(fileSize);
+  m_contentOffset = 0;
+  m_contentSize = (readFile() == 0) ? 0 : fileSize;
+}
+
 bool GameFile::close()
 {
-  delete[] originalBuffer;
+  m_data.reset();
   originalBuffer = 0;
   buffer = 0;
   eof = true;
   chunks.clear();
+  m_curChunk = 0;
+  m_partial = false;
+  m_contentOffset = 0;
+  m_contentSize = 0;
+  m_fileSize = 0;
   return doPostCloseOperation();
 }
 
 void GameFile::allocate(unsigned int s)
 {
-  if (originalBuffer)
-    delete[] originalBuffer;
-
   size = s;
 
-  originalBuffer = new unsigned char[size];
+  m_data.reset(new unsigned char[size], std::default_delete<unsigned char[]>());
+  originalBuffer = m_data.get();
   buffer = originalBuffer;
 
   if (size == 0)
@@ -95,39 +201,93 @@ void GameFile::allocate(unsigned int s)
     eof = false;
 }
 
-bool GameFile::setChunk(std::string chunkName, bool resetToStart)
+void GameFile::setExternalBuffer(unsigned char * data, unsigned int s)
 {
-  bool result = false;
+  m_data.reset();
 
-  // save current pointer if a chunk is currently under reading
-  for (auto it : chunks)
+  size = s;
+
+  originalBuffer = data;
+  buffer = originalBuffer;
+
+  eof = (size == 0);
+}
+
+void GameFile::setSharedBuffer(core::GameFileBuffer data, unsigned int s)
+{
+  m_data = data;
+
+  size = s;
+
+  originalBuffer = m_data.get();
+  buffer = originalBuffer;
+
+  eof = (size == 0);
+}
+
+bool GameFile::setChunk(std::string chunkName, bool resetToStart)
+{
+  if (chunkName.size() != 4)
   {
-    if (it.magic == curChunk)
-    {
-      it.pointer = pointer;
-      break;
-    }
+    LOG_ERROR << __FUNCTION__ << "Invalid chunk name" << chunkName.c_str();
+    return false;
   }
 
-  for (auto it : chunks)
+  return setChunk(core::fourcc(chunkName.c_str()), resetToStart);
+}
+
+bool GameFile::setChunk(unsigned int chunkName, bool resetToStart)
+{
+  // save current pointer if a chunk is currently under reading
+  core::ChunkDirectory::Chunk * current = chunks.find(m_curChunk);
+  if (current)
+    current->pointer = pointer;
+
+  core::ChunkDirectory::Chunk * chunk = chunks.find(chunkName);
+
+  if (!chunk)
   {
-    if (it.magic == chunkName)
-    {
-      buffer = originalBuffer + it.start;
-      pointer = (resetToStart?0:it.pointer);
-      size = it.size;
-      result = true;
-      eof = (pointer >= size);
-      break;
-    }
+    LOG_ERROR << __FUNCTION__ << "Cannot find chunk" << core::fourccName(chunkName).c_str();
+    return false;
   }
 
-  if (!result)
-    LOG_ERROR << __FUNCTION__ << "Cannot find chunk" << chunkName.c_str();
+  buffer = originalBuffer + chunk->start;
+  pointer = (resetToStart ? 0 : chunk->pointer);
+  size = chunk->size;
+  eof = (pointer >= size);
+  m_curChunk = chunkName;
+
+  return true;
+}
+
+core::FileDataPtr GameFile::data()
+{
+  QMutexLocker locker(&m_dataMutex);
+
+  core::FileDataPtr result = m_sharedData.lock();
+  if (result)
+    return result;
+
+  core::GameFileBuffer content;
+  unsigned int contentSize = 0;
+
+  if (!readContent(content, contentSize))
+    return result;
+
+  std::shared_ptr<core::FileData> fileData = std::make_shared<core::FileData>(content, contentSize);
+  buildChunks(fileData->data(), fileData->size(), fileData->chunks());
+
+  result = fileData;
+  m_sharedData = result;
 
   return result;
 }
 
+bool GameFile::hasChunk(const std::string & chunkName)
+{
+  return (chunkName.size() == 4) && hasChunk(core::fourcc(chunkName.c_str()));
+}
+
 size_t GameFile::getSize()
 {
   return size;
@@ -152,5 +312,5 @@ void GameFile::dumpStructure()
 {
   LOG_INFO << "Structure for file" << filepath;
   for (auto it : chunks)
-    LOG_INFO << "Chunk :" << it.magic.c_str() << it.start << it.size;
+    LOG_INFO << "Chunk :" << core::fourccName(it.magic).c_str() << it.start << it.size;
 }
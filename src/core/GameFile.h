@@ -12,6 +12,12 @@
 #include <string>
 #include <vector>
 
+#include <QMutex>
+
+#include "ChunkDirectory.h"
+#include "FileData.h"
+#include "FileReader.h"
+#include "GameFileCache.h" // GameFileBuffer
 #include "metaclasses/Component.h"
 
 #ifdef _WIN32
@@ -30,7 +36,7 @@ class _GAMEFILE_API_ GameFile : public Component
     GameFile(QString path, int id = -1) 
       : eof(true), buffer(0), pointer(0), size(0), 
         filepath(path), m_fileDataId(id), originalBuffer(0),
-        curChunk("")
+        m_curChunk(0), m_partial(false), m_contentOffset(0), m_contentSize(0), m_fileSize(0)
     {}
 
     virtual ~GameFile() {}
@@ -45,6 +51,15 @@ class _GAMEFILE_API_ GameFile : public Component
     void seekRelative(size_t offset);
     bool open();
     bool close();
+
+    // open only [offset, offset + length[ part of file, without decoding the rest of it when storage
+    // allows partial reads. Buffer then starts at given offset (position 0 is file byte at offset)
+    // and getSize() gives number of bytes actually available. No chunk parsing is done.
+    // On an opened file, range is served from memory when already read, otherwise it is read
+    // through the opened handle. A later open() exposes whole file, reading only what is missing
+    bool openRange(unsigned int offset, unsigned int length);
+    // probe file header without reading whole file
+    bool openHeader(unsigned int length) { return openRange(0, length); }
     
     void setFullName(const QString & name) { filepath = name; }
     QString fullname() const { return filepath; }
@@ -52,19 +67,60 @@ class _GAMEFILE_API_ GameFile : public Component
 
     void allocate(unsigned int size);
     bool setChunk(std::string chunkName, bool resetToStart = true);
+    bool setChunk(unsigned int chunkName, bool resetToStart = true);
     bool isChunked() { return chunks.size() > 0; }
+    bool hasChunk(const std::string & chunkName);
+    bool hasChunk(unsigned int chunkName) { return chunks.contains(chunkName); }
+
+    // typed view over whole chunk content, without moving current read position.
+    // Empty view if chunk doesn't exist
+    template <class T>
+    core::ChunkView<T> chunk(unsigned int chunkName)
+    {
+      const core::ChunkDirectory::Chunk * c = chunks.find(chunkName);
+      if (!c || !originalBuffer)
+        return core::ChunkView<T>();
+
+      return core::ChunkView<T>(originalBuffer + c->start, c->size);
+    }
 
     virtual void dumpStructure();
 
+    // Whole decoded content, shared by all users of the file. Unlike open() / read(), this
+    // can be called from any thread : file is decoded only once while some reference to
+    // its content is alive. Null if file cannot be read
+    core::FileDataPtr data();
+    // new independent cursor over file content
+    core::FileReader reader() { return core::FileReader(data()); }
+
   protected:
 
     virtual bool openFile() = 0;
     virtual bool isAlreadyOpened() = 0;
     virtual bool getFileSize(unsigned int & s) = 0;
     virtual unsigned long readFile() = 0;
+    // read size bytes of file starting at given offset into buffer. Storages not able to do
+    // partial reads return false (default), openRange() then falls back to a whole file read
+    virtual bool readFileRange(unsigned int offset, unsigned long & read) { return false; }
     virtual void doPostOpenOperation() = 0;
     virtual bool doPostCloseOperation() = 0;
 
+    // read whole file content, without using open() state (called by data(), possibly from
+    // several threads for different files)
+    virtual bool readContent(core::GameFileBuffer & content, unsigned int & contentSize) { return false; }
+    // fill chunk list for given content, if file is chunked
+    virtual void buildChunks(const unsigned char * content, unsigned int contentSize, core::ChunkDirectory & chunks) {}
+
+    // let inherited classes expose memory they already hold (mapped file for instance)
+    // instead of having open() allocating a new buffer and copying file content into it.
+    // Such memory is not freed by close(), inherited class releases it in doPostCloseOperation()
+    void setExternalBuffer(unsigned char * data, unsigned int size);
+
+    // same as above, for content shared with other files (cache for instance).
+    // Reference is released by close()
+    void setSharedBuffer(core::GameFileBuffer data, unsigned int size);
+    core::GameFileBuffer sharedBuffer() { return m_data; }
+
     bool eof;
     unsigned char *buffer;
     unsigned int pointer, size;
@@ -76,24 +132,27 @@ class _GAMEFILE_API_ GameFile : public Component
       unsigned __int32 size;
     };
 
-    struct Chunk
-    {
-      std::string magic;
-      unsigned int start;
-      unsigned int size;
-      unsigned int pointer;
-    };
-
-    std::vector<Chunk> chunks;
+    core::ChunkDirectory chunks;
 
   private:
     // disable copying
     GameFile(const GameFile &);
     void operator=(const GameFile &);
 
+    // read [offset, offset + length[ part of opened file into memory (whole file if storage can't)
+    void loadRange(unsigned int offset, unsigned int length, unsigned int fileSize);
+
     int m_fileDataId;
     unsigned char * originalBuffer;
-    std::string curChunk;
+    core::GameFileBuffer m_data; // owns originalBuffer, unless set by setExternalBuffer
+    unsigned int m_curChunk;
+    bool m_partial; // buffer only exposes part of file, see openRange
+    unsigned int m_contentOffset; // file offset of originalBuffer first byte
+    unsigned int m_contentSize; // number of file bytes held by originalBuffer
+    unsigned int m_fileSize; // whole file size, set when file is opened
+
+    QMutex m_dataMutex;
+    std::weak_ptr<const core::FileData> m_sharedData; // content handed out by data()
 };
 
 
@@ -0,0 +1,144 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+/*
+* GameFileCache.cpp
+*
+*  Created on: 18 Oct 2026
+*  Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+*/
+
+#include "GameFileCache.h"
+
+#include <QMutexLocker>
+
+#include "logger/Logger.h"
+
+core::GameFileCache::GameFileCache(size_t budget)
+  : m_budget(budget), m_memoryUsed(0), m_hits(0), m_misses(0), m_evictions(0)
+{
+}
+
+bool core::GameFileCache::get(int fileDataId, GameFileBuffer & buffer, unsigned int & size)
+{
+  QMutexLocker locker(&m_mutex);
+
+  auto it = m_entries.find(fileDataId);
+  if (it == m_entries.end())
+  {
+    m_misses++;
+    return false;
+  }
+
+  // move entry at the beginning of lru list
+  m_lru.splice(m_lru.begin(), m_lru, it->second.lruPos);
+
+  buffer = it->second.buffer;
+  size = it->second.size;
+  m_hits++;
+
+  return true;
+}
+
+bool core::GameFileCache::contains(int fileDataId)
+{
+  QMutexLocker locker(&m_mutex);
+  return m_entries.find(fileDataId) != m_entries.end();
+}
+
+void core::GameFileCache::put(int fileDataId, GameFileBuffer buffer, unsigned int size)
+{
+  if (fileDataId <= 0 || !buffer)
+    return;
+
+  QMutexLocker locker(&m_mutex);
+
+  // a file bigger than the whole budget would flush everything else for nothing
+  if (size > m_budget)
+    return;
+
+  auto it = m_entries.find(fileDataId);
+  if (it != m_entries.end())
+  {
+    m_memoryUsed -= it->second.size;
+    m_lru.erase(it->second.lruPos);
+    m_entries.erase(it);
+  }
+
+  m_lru.push_front(fileDataId);
+
+  Entry & entry = m_entries[fileDataId];
+  entry.buffer = buffer;
+  entry.size = size;
+  entry.lruPos = m_lru.begin();
+
+  m_memoryUsed += size;
+
+  evict();
+}
+
+void core::GameFileCache::remove(int fileDataId)
+{
+  QMutexLocker locker(&m_mutex);
+
+  auto it = m_entries.find(fileDataId);
+  if (it == m_entries.end())
+    return;
+
+  m_memoryUsed -= it->second.size;
+  m_lru.erase(it->second.lruPos);
+  m_entries.erase(it);
+}
+
+void core::GameFileCache::clear()
+{
+  QMutexLocker locker(&m_mutex);
+
+  m_entries.clear();
+  m_lru.clear();
+  m_memoryUsed = 0;
+}
+
+void core::GameFileCache::setBudget(size_t bytes)
+{
+  QMutexLocker locker(&m_mutex);
+
+  m_budget = bytes;
+  evict();
+}
+
+void core::GameFileCache::logStats()
+{
+  QMutexLocker locker(&m_mutex);
+
+  LOG_INFO << "File cache:" << m_entries.size() << "files"
+           << "-" << m_memoryUsed / 1024 << "/" << m_budget / 1024 << "Ko"
+           << "- hits" << m_hits << "misses" << m_misses << "evictions" << m_evictions;
+}
+
+void core::GameFileCache::evict()
+{
+  while (m_memoryUsed > m_budget && !m_lru.empty())
+  {
+    auto it = m_entries.find(m_lru.back());
+    m_memoryUsed -= it->second.size;
+    m_entries.erase(it);
+    m_lru.pop_back();
+    m_evictions++;
+  }
+}
@@ -0,0 +1,103 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+/*
+* GameFileCache.h
+*
+*  Created on: 18 Oct 2026
+*  Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+*/
+
+#ifndef _GAMEFILECACHE_H_
+#define _GAMEFILECACHE_H_
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+#include <QMutex>
+
+#ifdef _WIN32
+#    ifdef BUILDING_CORE_DLL
+#        define _GAMEFILECACHE_API_ __declspec(dllexport)
+#    else
+#        define _GAMEFILECACHE_API_ __declspec(dllimport)
+#    endif
+#else
+#    define _GAMEFILECACHE_API_
+#endif
+
+namespace core
+{
+  // Decoded file content, shared between the cache and every GameFile currently using it.
+  // Content must be considered as read only once shared.
+  typedef std::shared_ptr<unsigned char> GameFileBuffer;
+
+  // LRU cache of decoded file contents, keyed by file data id, limited by a memory budget.
+  // Buffers stay alive as long as a GameFile uses them, even if evicted from cache meanwhile.
+  // All methods can be called from any thread.
+  class _GAMEFILECACHE_API_ GameFileCache
+  {
+    public:
+      static const size_t DEFAULT_BUDGET = 256 * 1024 * 1024;
+
+      explicit GameFileCache(size_t budget = DEFAULT_BUDGET);
+
+      // return true and fill buffer and size if file is in cache
+      bool get(int fileDataId, GameFileBuffer & buffer, unsigned int & size);
+      bool contains(int fileDataId);
+      void put(int fileDataId, GameFileBuffer buffer, unsigned int size);
+      void remove(int fileDataId);
+      void clear();
+
+      void setBudget(size_t bytes);
+      size_t budget() const { return m_budget; }
+      size_t memoryUsed() const { return m_memoryUsed; }
+
+      unsigned int hits() const { return m_hits; }
+      unsigned int misses() const { return m_misses; }
+      unsigned int evictions() const { return m_evictions; }
+
+      void logStats();
+
+    private:
+      struct Entry
+      {
+        GameFileBuffer buffer;
+        unsigned int size;
+        std::list<int>::iterator lruPos;
+      };
+
+      // remove least recently used entries until memory used fits in budget
+      void evict();
+
+      std::unordered_map<int, Entry> m_entries;
+      std::list<int> m_lru; // most recently used first
+
+      size_t m_budget;
+      size_t m_memoryUsed;
+
+      unsigned int m_hits;
+      unsigned int m_misses;
+      unsigned int m_evictions;
+
+      QMutex m_mutex;
+  };
+}
+
+#endif /* _GAMEFILECACHE_H_ */
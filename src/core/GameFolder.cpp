@@ -7,41 +7,128 @@
 
 #include "GameFolder.h"
 
+#include <algorithm>
+
+#include <QAtomicInt>
 #include <QDirIterator>
 #include <QFile>
+#include <QMutexLocker>
+#include <QReadLocker>
+#include <QWriteLocker>
 #include <QRegularExpression>
+#include <QRunnable>
 
 #include "logger/Logger.h"
 
+namespace core
+{
+  // files prefetched by a single call to GameFolder::prefetch
+  struct PrefetchRequest
+  {
+    QAtomicInt remaining;
+    std::function<void()> callback;
+  };
+
+  class PrefetchTask : public QRunnable
+  {
+    public:
+      PrefetchTask(GameFolder & folder, GameFile * file, std::shared_ptr<PrefetchRequest> request)
+        : m_folder(folder), m_file(file), m_request(request)
+      {}
+
+      void run()
+      {
+        m_folder.runPrefetch(m_file);
+
+        if (!m_request->remaining.deref() && m_request->callback)
+          m_request->callback();
+      }
+
+    private:
+      GameFolder & m_folder;
+      GameFile * m_file;
+      std::shared_ptr<PrefetchRequest> m_request;
+  };
+}
+
 core::GameFolder::GameFolder(const QString & path)
-  : m_path(path)
+  : m_filesLock(QReadWriteLock::Recursive), m_path(path)
 {
 }
 
 
+QString core::GameFolder::normalizedPath(QString path)
+{
+  return path.toLower().replace('\\', '/');
+}
+
 QString core::GameFolder::getFullPathForFile(QString file)
 {
   file = file.toLower();
-  for(GameFolder::iterator it = begin() ; it != end() ; ++it)
-  {
-    if((*it)->name() == file)
-      return (*it)->fullname();
-  }
+
+  QReadLocker locker(&m_filesLock);
+
+  auto it = m_baseNameMap.constFind(file);
+  if (it != m_baseNameMap.constEnd())
+    return it.value()->fullname();
+
+  unsigned int entry = m_fileTable.findByBaseName(file.toUtf8());
+  if (entry != FileTable::npos)
+    return QString::fromUtf8(m_fileTable.path(entry));
 
   return "";
 }
 
 void core::GameFolder::getFilesForFolder(std::vector<GameFile *> &fileNames, QString folderPath, QString extension)
 {
-  for(GameFolder::iterator it = begin() ; it != end() ; ++it)
+  folderPath = normalizedPath(folderPath);
+  extension = extension.toLower();
+
+  QByteArray ext = extension.toUtf8();
+  std::vector<unsigned int> entries;
+  std::vector<std::pair<QString, GameFile *> > files;
+
   {
-    GameFile * file = *it;
-    if(file->fullname().startsWith(folderPath, Qt::CaseInsensitive) &&
-       (!extension.size() || file->fullname().endsWith(extension, Qt::CaseInsensitive)))
+    QReadLocker locker(&m_filesLock);
+
+    std::vector<unsigned int> folderEntries;
+    m_fileTable.findByPrefix(folderPath.toUtf8(), folderEntries);
+    for (auto entry : folderEntries)
+    {
+      if (ext.isEmpty() || m_fileTable.path(entry).endsWith(ext))
+        entries.push_back(entry);
+    }
+
+    // all paths starting with folderPath are stored consecutively, starting from lower_bound
+    for (auto it = m_nameMap.lower_bound(folderPath); it != m_nameMap.end() && it->first.startsWith(folderPath); ++it)
     {
-      fileNames.push_back(file);
+      if ((extension.isEmpty() || it->first.endsWith(extension)) && !isInTable(it->first))
+        files.push_back(*it);
     }
   }
+
+  // table files are created out of read lock, as it needs write lock
+  if (files.empty())
+  {
+    for (auto entry : entries)
+    {
+      GameFile * file = getTableFile(entry);
+      if (file)
+        fileNames.push_back(file);
+    }
+    return;
+  }
+
+  for (auto entry : entries)
+  {
+    GameFile * file = getTableFile(entry);
+    if (file)
+      files.push_back(std::make_pair(normalizedPath(file->fullname()), file));
+  }
+
+  std::sort(files.begin(), files.end());
+  for (auto & it : files)
+    fileNames.push_back(it.second);
 }
 
 void core::GameFolder::getFilteredFiles(std::set<GameFile *> &dest, QString & filter)
@@ -53,35 +140,247 @@ void core::GameFolder::getFilteredFiles(std::set<GameFile *> &dest, QString & fi
     LOG_ERROR << regex.errorString();
     return;
   }
-  for(GameFolder::iterator it = begin() ; it != end() ; ++it)
+
+  std::vector<unsigned int> entries;
+
   {
-    if((*it)->name().contains(regex))
+    QReadLocker locker(&m_filesLock);
+
+    for (unsigned int i = 0; i < m_fileTable.size(); i++)
+    {
+      if (QString::fromUtf8(m_fileTable.baseName(i)).contains(regex))
+        entries.push_back(i);
+    }
+
+    for(GameFolder::iterator it = begin() ; it != end() ; ++it)
     {
-      dest.insert(*it);
+      if((*it)->name().contains(regex) && !isInTable(normalizedPath((*it)->fullname())))
+      {
+        dest.insert(*it);
+      }
     }
   }
+
+  for (auto entry : entries)
+  {
+    GameFile * file = getTableFile(entry);
+    if (file)
+      dest.insert(file);
+  }
+}
+
+void core::GameFolder::searchFiles(std::vector<GameFile *> & files, FileNameIndex::Result & result, const QString & text, const QString & extension)
+{
+  std::vector<unsigned int> entries;
+
+  {
+    QReadLocker filesLocker(&m_filesLock);
+    QMutexLocker locker(&m_nameIndexMutex);
+
+    unsigned int tableSize = m_fileTable.size();
+
+    if (m_nameIndex.empty())
+    {
+      for (unsigned int i = 0; i < tableSize; i++)
+        m_nameIndex.add(m_fileTable.baseName(i), i);
+
+      m_indexedChildren.clear();
+      for (auto it : m_nameMap)
+      {
+        if (isInTable(it.first))
+          continue;
+
+        m_nameIndex.add(it.second->name().toLower().toUtf8(), tableSize + (unsigned int)m_indexedChildren.size());
+        m_indexedChildren.push_back(it.second);
+      }
+    }
+
+    m_nameIndex.search(result, text, extension);
+
+    for (auto handle : result.handles())
+    {
+      if (handle < tableSize)
+        entries.push_back(handle);
+      else
+        files.push_back(m_indexedChildren[handle - tableSize]);
+    }
+  }
+
+  for (auto entry : entries)
+  {
+    GameFile * file = getTableFile(entry);
+    if (file)
+      files.push_back(file);
+  }
 }
 
 GameFile * core::GameFolder::getFile(QString filename)
 {
-  filename = filename.toLower().replace('\\','/');
+  filename = normalizedPath(filename);
 
-  GameFile * result = 0;
+  unsigned int entry = FileTable::npos;
 
-  auto it = m_nameMap.find(filename);
+  {
+    QReadLocker locker(&m_filesLock);
+    auto it = m_nameMap.find(filename);
+    if (it != m_nameMap.end())
+      return it->second;
+
+    entry = m_fileTable.find(filename.toUtf8());
+  }
+
+  if (entry != FileTable::npos)
+    return getTableFile(entry);
+
+  return 0;
+}
+
+void core::GameFolder::setFileTable(FileTable && table)
+{
+  QWriteLocker locker(&m_filesLock);
+  m_fileTable = std::move(table);
+  clearNameIndex();
+}
+
+GameFile * core::GameFolder::getTableFile(unsigned int entry)
+{
+  QString path;
+
+  {
+    QReadLocker locker(&m_filesLock);
+    path = QString::fromUtf8(m_fileTable.path(entry));
+
+    // already created, or replaced by a custom file
+    auto it = m_nameMap.find(path);
+    if (it != m_nameMap.end())
+      return it->second;
+  }
+
+  // keep lock until file is added, so that two threads asking for same file don't create it twice
+  QWriteLocker locker(&m_filesLock);
+
+  auto it = m_nameMap.find(path);
   if (it != m_nameMap.end())
-    result = it->second;
+    return it->second;
+
+  GameFile * file = createFile(path, m_fileTable.id(entry));
+  if (file)
+    addChild(file);
+
+  return file;
+}
 
-  return result;
+bool core::GameFolder::isInTable(const QString & path) const
+{
+  return m_fileTable.find(path.toUtf8()) != FileTable::npos;
+}
+
+void core::GameFolder::clearNameIndex()
+{
+  QMutexLocker locker(&m_nameIndexMutex);
+  if (!m_nameIndex.empty())
+    m_nameIndex.clear();
+  m_indexedChildren.clear();
+}
+
+void core::GameFolder::prefetch(const std::vector<int> & fileDataIds, std::function<void()> callback)
+{
+  std::vector<GameFile *> files;
+  files.reserve(fileDataIds.size());
+
+  {
+    QMutexLocker locker(&m_prefetchMutex);
+
+    for (auto id : fileDataIds)
+    {
+      if (m_cache.contains(id) || m_prefetchStates.find(id) != m_prefetchStates.end())
+        continue;
+
+      GameFile * file = getFile(id);
+      if (!file)
+        continue;
+
+      m_prefetchStates[id] = PREFETCH_QUEUED;
+      files.push_back(file);
+    }
+  }
+
+  std::shared_ptr<PrefetchRequest> request = std::make_shared<PrefetchRequest>();
+  request->remaining = (int)files.size();
+  request->callback = callback;
+
+  if (files.empty())
+  {
+    if (callback)
+      callback();
+    return;
+  }
+
+  for (auto it : files)
+    m_prefetchPool.start(new PrefetchTask(*this, it, request));
+}
+
+void core::GameFolder::waitForPrefetch(int fileDataId)
+{
+  QMutexLocker locker(&m_prefetchMutex);
+
+  auto it = m_prefetchStates.find(fileDataId);
+  if (it == m_prefetchStates.end())
+    return;
+
+  // not started yet, simply cancel it
+  if (it->second == PREFETCH_QUEUED)
+  {
+    m_prefetchStates.erase(it);
+    return;
+  }
+
+  while (m_prefetchStates.find(fileDataId) != m_prefetchStates.end())
+    m_prefetchDone.wait(&m_prefetchMutex);
+}
+
+void core::GameFolder::runPrefetch(GameFile * file)
+{
+  int id = file->fileDataId();
+
+  {
+    QMutexLocker locker(&m_prefetchMutex);
+    auto it = m_prefetchStates.find(id);
+    if (it == m_prefetchStates.end()) // cancelled meanwhile
+      return;
+    it->second = PREFETCH_RUNNING;
+  }
+
+  GameFileBuffer buffer;
+  unsigned int size = 0;
+  if (decodeFile(file, buffer, size))
+    m_cache.put(id, buffer, size);
+
+  QMutexLocker locker(&m_prefetchMutex);
+  m_prefetchStates.erase(id);
+  m_prefetchDone.wakeAll();
 }
 
 void core::GameFolder::onChildAdded(GameFile * child)
 {
-  m_nameMap[child->fullname()] = child;
+  QWriteLocker locker(&m_filesLock);
+  QString path = normalizedPath(child->fullname());
+  m_nameMap[path] = child;
+  m_baseNameMap.insert(child->name().toLower(), child);
+
+  // name index already knows table paths (and resolves them through m_nameMap)
+  if (!isInTable(path))
+    clearNameIndex();
 }
 
 void core::GameFolder::onChildRemoved(GameFile * child)
 {
-  m_nameMap.erase(child->fullname());
+  QWriteLocker locker(&m_filesLock);
+  QString path = normalizedPath(child->fullname());
+  m_nameMap.erase(path);
+  m_baseNameMap.remove(child->name().toLower(), child);
+
+  if (!isInTable(path))
+    clearNameIndex();
 }
 
@@ -8,12 +8,21 @@
 #ifndef _GAMEFOLDER_H_
 #define _GAMEFOLDER_H_
 
+#include <functional>
 #include <map>
 #include <set>
 
+#include <QMultiHash>
+#include <QMutex>
+#include <QReadWriteLock>
 #include <QString>
+#include <QThreadPool>
+#include <QWaitCondition>
 
+#include "FileNameIndex.h"
+#include "FileTable.h"
 #include "GameFile.h"
+#include "GameFileCache.h"
 
 #include "metaclasses/Container.h"
 
@@ -39,11 +48,15 @@ namespace core
   class _GAMEFOLDER_API_ GameFolder : public Container<GameFile>
   {
     public:
+      // called with number of processed items and total number of items
+      typedef std::function<void(unsigned int, unsigned int)> ProgressCallback;
+
       explicit GameFolder(const QString & path);
       virtual ~GameFolder() {}
 
       virtual void init() = 0;
-      virtual void initFromListfile(const QString & file) = 0;
+      // progress (if any) is called from calling thread
+      virtual void initFromListfile(const QString & file, ProgressCallback progress = ProgressCallback()) = 0;
       virtual void addCustomFiles(const QString & path, bool bypassOriginalFiles) = 0;
 
       // return full path for a given file ie :
@@ -51,12 +64,20 @@ namespace core
       // (not always accurate, as file names not always unique)
       QString getFullPathForFile(QString file);
 
+      // files under given folder (sub folders included), sorted by path
       void getFilesForFolder(std::vector<GameFile *> &fileNames, QString folderPath, QString extension = "");
       void getFilteredFiles(std::set<GameFile *> &dest, QString & filter);
+      // files with given extension whose name contains text (case insensitive), using a trigram
+      // index built on first call. Give back previous result so that it is only narrowed while text grows
+      void searchFiles(std::vector<GameFile *> & files, FileNameIndex::Result & result, const QString & text, const QString & extension);
       GameFile * getFile(QString filename);
       virtual GameFile * getFile(int id) = 0;
 
       virtual bool openFile(std::string file, void ** result) = 0;
+      virtual bool readFile(void * file, unsigned char * buffer, unsigned int size, unsigned long * read) = 0;
+      // same as above, starting at given offset in file
+      virtual bool readFileRange(void * file, unsigned int offset, unsigned char * buffer, unsigned int size, unsigned long * read) = 0;
+      virtual bool closeFile(void * file) = 0;
 
       virtual QString version() = 0;
       virtual QString locale() = 0;
@@ -70,9 +91,63 @@ namespace core
 
       QString path() { return m_path; }
 
+      // decoded files shared across opens, see GameFileCache
+      GameFileCache & cache() { return m_cache; }
+
+      // decode given files on worker threads and keep them in cache for a later open().
+      // callback (if any) is called from a worker thread once all files are processed
+      void prefetch(const std::vector<int> & fileDataIds, std::function<void()> callback = std::function<void()>());
+
+      // make sure no worker is decoding given file. If a prefetch is queued but not
+      // started yet, it is cancelled (caller will decode file itself), if it is running, wait for it
+      void waitForPrefetch(int fileDataId);
+
+      // decode whole file content, without using file open state. Called from prefetch
+      // worker threads and GameFile::data(), so must be thread safe
+      virtual bool decodeFile(GameFile * file, GameFileBuffer & buffer, unsigned int & size) { return false; }
+
+    protected:
+      // replace table of known files (GameFile objects are created from it on demand, see createFile)
+      void setFileTable(FileTable && table);
+
+      // GameFile object for given table entry. Created (and added as child) on first call
+      GameFile * getTableFile(unsigned int entry);
+      virtual GameFile * createFile(const QString & path, int id) { return 0; }
+
+      // protects file lookup maps, as files can be searched (and created on the fly by id)
+      // from loading threads. Recursive, so that onChildAdded can be reached while holding it
+      QReadWriteLock m_filesLock;
+
+      FileTable m_fileTable; // files known by folder. Children only hold files actually used, and files not in table
+
     private:
-      std::map<QString, GameFile *> m_nameMap;
+      friend class PrefetchTask;
+
+      enum PrefetchState
+      {
+        PREFETCH_QUEUED,
+        PREFETCH_RUNNING
+      };
+
+      void runPrefetch(GameFile * file);
+
+      bool isInTable(const QString & path) const;
+      void clearNameIndex();
+
+      // lookup maps for children, keys are case folded once at insertion (see normalizedPath)
+      static QString normalizedPath(QString path);
+      std::map<QString, GameFile *> m_nameMap; // full path => file, sorted so that folder listing is a range query
+      QMultiHash<QString, GameFile *> m_baseNameMap; // file name (without folder) => files
+      FileNameIndex m_nameIndex; // built on first search, dropped when files out of table change
+      std::vector<GameFile *> m_indexedChildren; // files out of table in name index, their handles follow table entries
+      QMutex m_nameIndexMutex; // always taken after m_filesLock
       QString m_path;
+      GameFileCache m_cache;
+
+      QMutex m_prefetchMutex;
+      QWaitCondition m_prefetchDone;
+      std::map<int, PrefetchState> m_prefetchStates;
+      QThreadPool m_prefetchPool; // keep last, so that it is destroyed (and waits for its tasks) first
   };
 }
 
@@ -0,0 +1,225 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+/*
+* ListfileIndex.cpp
+*
+*  Created on: 18 Oct 2026
+*  Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+*/
+
+#include "ListfileIndex.h"
+
+#include <algorithm>
+#include <cstring> // memcmp
+
+#include <QSaveFile>
+
+#include "logger/Logger.h"
+
+namespace
+{
+  const char INDEX_MAGIC[4] = { 'W', 'M', 'V', 'L' };
+
+  unsigned int padding(unsigned int size)
+  {
+    return (4 - (size % 4)) % 4;
+  }
+}
+
+core::ListfileIndex::ListfileIndex()
+  : m_data(0), m_entries(0), m_names(0), m_count(0)
+{
+}
+
+core::ListfileIndex::~ListfileIndex()
+{
+  close();
+}
+
+bool core::ListfileIndex::load(const QString & file, const QByteArray & key)
+{
+  return map(file, &key);
+}
+
+bool core::ListfileIndex::load(const QString & file)
+{
+  return map(file, 0);
+}
+
+bool core::ListfileIndex::map(const QString & file, const QByteArray * key)
+{
+  close();
+
+  m_file.setFileName(file);
+  if (!m_file.open(QIODevice::ReadOnly))
+    return false;
+
+  qint64 fileSize = m_file.size();
+  if (fileSize < (qint64)sizeof(Header))
+  {
+    close();
+    return false;
+  }
+
+  m_data = m_file.map(0, fileSize);
+  if (!m_data)
+  {
+    LOG_ERROR << "Mapping listfile index" << file << "failed";
+    close();
+    return false;
+  }
+
+  const Header * header = reinterpret_cast<const Header *>(m_data);
+  if (memcmp(header->magic, INDEX_MAGIC, 4) != 0 || header->version != FORMAT_VERSION)
+  {
+    LOG_INFO << "Listfile index" << file << "has unknown format, ignoring it";
+    close();
+    return false;
+  }
+
+  quint64 keyPos = sizeof(Header);
+  quint64 entriesPos = keyPos + header->keySize + padding(header->keySize);
+  quint64 namesPos = entriesPos + (quint64)header->count * sizeof(IndexEntry);
+
+  if (namesPos + header->namesSize > (quint64)fileSize)
+  {
+    LOG_ERROR << "Listfile index" << file << "is truncated, ignoring it";
+    close();
+    return false;
+  }
+
+  if (key && QByteArray::fromRawData((const char *)m_data + keyPos, header->keySize) != *key)
+  {
+    LOG_INFO << "Listfile index" << file << "was built for another game version, ignoring it";
+    close();
+    return false;
+  }
+
+  const IndexEntry * entries = reinterpret_cast<const IndexEntry *>(m_data + entriesPos);
+  for (unsigned int i = 0; i < header->count; i++)
+  {
+    if ((quint64)entries[i].nameOffset + entries[i].nameSize > header->namesSize)
+    {
+      LOG_ERROR << "Listfile index" << file << "is corrupted, ignoring it";
+      close();
+      return false;
+    }
+  }
+
+  m_entries = entries;
+  m_names = (const char *)m_data + namesPos;
+  m_count = header->count;
+
+  return true;
+}
+
+void core::ListfileIndex::close()
+{
+  if (m_data)
+    m_file.unmap(m_data);
+
+  if (m_file.isOpen())
+    m_file.close();
+
+  m_data = 0;
+  m_entries = 0;
+  m_names = 0;
+  m_count = 0;
+}
+
+bool core::ListfileIndex::save(const QString & file, const QByteArray & key, std::vector<Entry> & entries)
+{
+  std::sort(entries.begin(), entries.end());
+
+  std::vector<IndexEntry> indexEntries;
+  indexEntries.reserve(entries.size());
+
+  QByteArray names;
+  for (auto & it : entries)
+  {
+    IndexEntry entry;
+    entry.nameOffset = names.size();
+    entry.nameSize = it.name.size();
+    entry.id = it.id;
+    indexEntries.push_back(entry);
+    names += it.name;
+  }
+
+  Header header;
+  memcpy(header.magic, INDEX_MAGIC, 4);
+  header.version = FORMAT_VERSION;
+  header.keySize = key.size();
+  header.count = (unsigned int)indexEntries.size();
+  header.namesSize = names.size();
+
+  // write in a temporary file, renamed on commit : a crash never leaves a partial index behind
+  QSaveFile out(file);
+  if (!out.open(QIODevice::WriteOnly))
+  {
+    LOG_ERROR << "Fail to create listfile index" << file;
+    return false;
+  }
+
+  out.write((const char *)&header, sizeof(header));
+  out.write(key);
+  out.write(QByteArray(padding(key.size()), '\0'));
+  out.write((const char *)indexEntries.data(), indexEntries.size() * sizeof(IndexEntry));
+  out.write(names);
+
+  if (!out.commit())
+  {
+    LOG_ERROR << "Fail to write listfile index" << file;
+    return false;
+  }
+
+  return true;
+}
+
+unsigned int core::ListfileIndex::id(unsigned int index) const
+{
+  return (index < m_count) ? m_entries[index].id : 0;
+}
+
+QByteArray core::ListfileIndex::name(unsigned int index) const
+{
+  if (index >= m_count)
+    return QByteArray();
+
+  return QByteArray::fromRawData(m_names + m_entries[index].nameOffset, m_entries[index].nameSize);
+}
+
+unsigned int core::ListfileIndex::find(const QByteArray & name) const
+{
+  // entries are sorted by name : binary search
+  unsigned int first = 0, last = m_count;
+  while (first < last)
+  {
+    unsigned int middle = first + (last - first) / 2;
+    QByteArray current = this->name(middle);
+
+    if (current < name)
+      first = middle + 1;
+    else if (name < current)
+      last = middle;
+    else
+      return m_entries[middle].id;
+  }
+
+  return 0;
+}
@@ -0,0 +1,119 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+/*
+* ListfileIndex.h
+*
+*  Created on: 18 Oct 2026
+*  Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+*/
+
+#ifndef _LISTFILEINDEX_H_
+#define _LISTFILEINDEX_H_
+
+#include <vector>
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+#ifdef _WIN32
+#    ifdef BUILDING_CORE_DLL
+#        define _LISTFILEINDEX_API_ __declspec(dllexport)
+#    else
+#        define _LISTFILEINDEX_API_ __declspec(dllimport)
+#    endif
+#else
+#    define _LISTFILEINDEX_API_
+#endif
+
+namespace core
+{
+  // Binary form of a resolved listfile : (file name, file data id) pairs sorted by name.
+  // It is written once, then mapped in memory on next startups instead of resolving
+  // every listfile line again. A key (typically game build) is stored along with data,
+  // so that an index built for another build is never used.
+  //
+  // Layout : header | key (padded to 4 bytes) | entries | names
+  class _LISTFILEINDEX_API_ ListfileIndex
+  {
+    public:
+      struct Entry
+      {
+        QByteArray name; // lower case, '/' separated
+        unsigned int id;
+
+        bool operator<(const Entry & other) const { return name < other.name; }
+      };
+
+      ListfileIndex();
+      ~ListfileIndex();
+
+      // map given index file in memory. Fails if file doesn't exist, is corrupted or was built with another key
+      bool load(const QString & file, const QByteArray & key);
+      // same, whatever key file was built with
+      bool load(const QString & file);
+      void close();
+
+      // sort given entries and write them to file
+      static bool save(const QString & file, const QByteArray & key, std::vector<Entry> & entries);
+
+      bool isValid() const { return m_entries != 0; }
+      QString fileName() const { return m_file.fileName(); }
+      unsigned int size() const { return m_count; }
+
+      unsigned int id(unsigned int index) const;
+      // name of given entry. Returned array points into mapped memory, it is valid until index is closed
+      QByteArray name(unsigned int index) const;
+
+      // file data id for given name (lower case, '/' separated), 0 if not in index
+      unsigned int find(const QByteArray & name) const;
+
+    private:
+      ListfileIndex(const ListfileIndex &);
+      void operator=(const ListfileIndex &);
+
+      bool map(const QString & file, const QByteArray * key);
+
+      struct Header
+      {
+        char magic[4];
+        unsigned int version;
+        unsigned int keySize;
+        unsigned int count;
+        unsigned int namesSize;
+      };
+
+      struct IndexEntry
+      {
+        unsigned int nameOffset;
+        unsigned int nameSize;
+        unsigned int id;
+      };
+
+      static const unsigned int FORMAT_VERSION = 1;
+
+      QFile m_file;
+      unsigned char * m_data;
+      const IndexEntry * m_entries;
+      const char * m_names;
+      unsigned int m_count;
+  };
+}
+
+#endif /* _LISTFILEINDEX_H_ */
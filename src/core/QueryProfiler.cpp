@@ -0,0 +1,467 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+/*
+* QueryProfiler.cpp
+*
+*  Created on: 18 Oct 2026
+*  Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+*/
+
+#include "QueryProfiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+#include <QFile>
+#include <QMutexLocker>
+#include <QTextStream>
+
+#include "logger/Logger.h"
+
+bool core::QueryProfiler::s_enabled = false;
+
+namespace
+{
+  // execution times histogram : 4 buckets per power of 2 ns, up to 2^40 ns (~18 minutes)
+  const int BUCKETS_PER_OCTAVE = 4;
+  const int NB_BUCKETS = 40 * BUCKETS_PER_OCTAVE;
+
+  int bucket(qint64 time)
+  {
+    if (time <= 1)
+      return 0;
+
+    return std::min(NB_BUCKETS - 1, (int)(std::log2((double)time) * BUCKETS_PER_OCTAVE));
+  }
+
+  // append a parameter to a normalized query, merging it with previous one in lists ("?, ?" -> "?")
+  void appendParameter(QString & query)
+  {
+    int end = query.size();
+    while (end > 0 && query[end - 1] == ' ')
+      end--;
+
+    if (end > 0 && query[end - 1] == ',')
+    {
+      int previous = end - 1;
+      while (previous > 0 && query[previous - 1] == ' ')
+        previous--;
+
+      if (previous > 0 && query[previous - 1] == '?')
+      {
+        query.truncate(previous);
+        return;
+      }
+    }
+
+    query += '?';
+  }
+
+  bool isIdentifierChar(QChar c)
+  {
+    return c.isLetterOrNumber() || c == '_';
+  }
+
+  // "...TABLE name [AS alias]..." -> name
+  QString tableName(const QString & detail)
+  {
+    int begin = detail.indexOf("TABLE ");
+    if (begin == -1)
+      return QString();
+
+    begin += 6;
+    int end = detail.indexOf(' ', begin);
+    return detail.mid(begin, (end == -1) ? -1 : end - begin);
+  }
+
+  // index a plan detail reads through ("USING [COVERING] INDEX name", or primary key of a table
+  // without rowid), empty if none or if index is an automatic one
+  QString indexName(const QString & detail, bool & covering)
+  {
+    int begin = detail.indexOf(" USING ");
+    if (begin == -1)
+      return QString();
+
+    QString index = detail.mid(begin + 7);
+    covering = index.startsWith("COVERING INDEX ");
+
+    if (index.startsWith("PRIMARY KEY"))
+      return tableName(detail) + " primary key";
+
+    if (!covering && !index.startsWith("INDEX "))
+      return QString();
+
+    index = index.mid(covering ? 15 : 6);
+    return index.left(index.indexOf(' '));
+  }
+}
+
+core::QueryProfiler::Statistics::Statistics()
+  : executions(0), rows(0), time(0), fullScanSteps(0), histogram(NB_BUCKETS, 0)
+{
+}
+
+qint64 core::QueryProfiler::Statistics::percentile(double fraction) const
+{
+  qint64 target = (qint64)std::ceil(fraction * executions);
+  qint64 count = 0;
+
+  for (int i = 0; i < NB_BUCKETS; i++)
+  {
+    count += histogram[i];
+    if (count >= target && count > 0)
+      return (qint64)std::pow(2.0, (double)(i + 1) / BUCKETS_PER_OCTAVE);
+  }
+
+  return 0;
+}
+
+QString core::QueryProfiler::normalize(const QString & query)
+{
+  QString result;
+  result.reserve(query.size());
+
+  const int size = query.size();
+
+  for (int i = 0; i < size; i++)
+  {
+    QChar c = query[i];
+
+    if (c == '\'')
+    {
+      // string literal, '' being an escaped quote
+      for (i++; i < size; i++)
+      {
+        if (query[i] != '\'')
+          continue;
+
+        if (i + 1 < size && query[i + 1] == '\'')
+          i++;
+        else
+          break;
+      }
+      appendParameter(result);
+    }
+    else if (c == '?' || (c.isDigit() && (result.isEmpty() || !isIdentifierChar(result[result.size() - 1]))))
+    {
+      // parameter (possibly numbered) or number (possibly real or hexadecimal)
+      while (i + 1 < size && (query[i + 1].isLetterOrNumber() || query[i + 1] == '.'))
+        i++;
+      appendParameter(result);
+    }
+    else if (c.isSpace())
+    {
+      if (!result.isEmpty() && !result.endsWith(' '))
+        result += ' ';
+    }
+    else
+    {
+      result += c;
+    }
+  }
+
+  return result.trimmed();
+}
+
+void core::QueryProfiler::record(sqlite3 * db, const QString & query, qint64 time, unsigned int rows, unsigned int fullScanSteps)
+{
+  QString key = normalize(query);
+  bool newTemplate = false;
+
+  {
+    QMutexLocker locker(&m_mutex);
+
+    auto it = m_statistics.find(key);
+    if (it == m_statistics.end())
+    {
+      it = m_statistics.insert(std::make_pair(key, Statistics())).first;
+      newTemplate = true;
+    }
+
+    Statistics & stats = it->second;
+    stats.executions++;
+    stats.rows += rows;
+    stats.time += time;
+    stats.fullScanSteps += fullScanSteps;
+    stats.histogram[bucket(time)]++;
+  }
+
+  if (!newTemplate)
+    return;
+
+  // plan is computed outside of lock, as it runs a statement
+  Statistics plan;
+  explain(db, query, plan);
+
+  QMutexLocker locker(&m_mutex);
+  Statistics & stats = m_statistics[key];
+  stats.plan = plan.plan;
+  stats.scannedTables = plan.scannedTables;
+  stats.automaticIndexes = plan.automaticIndexes;
+}
+
+void core::QueryProfiler::explain(sqlite3 * db, const QString & query, Statistics & stats)
+{
+  QString statement = query.trimmed();
+
+  if (!statement.startsWith("SELECT", Qt::CaseInsensitive) && !statement.startsWith("WITH", Qt::CaseInsensitive) &&
+      !statement.startsWith("UPDATE", Qt::CaseInsensitive) && !statement.startsWith("DELETE", Qt::CaseInsensitive))
+    return;
+
+  // a scan is expected when whole table is read, only flag it when rows are filtered or joined
+  bool filtered = statement.contains(" WHERE ", Qt::CaseInsensitive) || statement.contains(" JOIN ", Qt::CaseInsensitive);
+
+  sqlite3_stmt * explainStatement = 0;
+  if (sqlite3_prepare_v2(db, ("EXPLAIN QUERY PLAN " + statement).toUtf8().constData(), -1, &explainStatement, 0) != SQLITE_OK)
+  {
+    LOG_ERROR << "Explaining query" << statement;
+    LOG_ERROR << "SQL error:" << sqlite3_errmsg(db);
+    sqlite3_finalize(explainStatement);
+    return;
+  }
+
+  // rows are (selectid, order, from, detail)
+  while (sqlite3_step(explainStatement) == SQLITE_ROW)
+  {
+    QString detail = QString::fromUtf8(reinterpret_cast<const char *>(sqlite3_column_text(explainStatement, 3)));
+    stats.plan << detail;
+
+    QString table = tableName(detail);
+    if (table.isEmpty())
+      continue;
+
+    if (detail.startsWith("SCAN TABLE") && !detail.contains(" USING ") && filtered && !stats.scannedTables.contains(table))
+    {
+      stats.scannedTables << table;
+    }
+    else if (detail.contains("AUTOMATIC"))
+    {
+      // "SEARCH TABLE t USING AUTOMATIC COVERING INDEX (a=? AND b=?)"
+      int begin = detail.indexOf('(');
+      int end = detail.lastIndexOf(')');
+      QStringList columns;
+
+      if (begin != -1 && end > begin)
+      {
+        for (QString constraint : detail.mid(begin + 1, end - begin - 1).split(" AND "))
+        {
+          int op = 0;
+          while (op < constraint.size() && constraint[op] != '=' && constraint[op] != '<' && constraint[op] != '>')
+            op++;
+          columns << constraint.left(op).trimmed();
+        }
+      }
+
+      stats.automaticIndexes << QString("%1(%2)").arg(table).arg(columns.join(","));
+    }
+  }
+
+  sqlite3_finalize(explainStatement);
+}
+
+std::map<QString, core::QueryProfiler::Statistics> core::QueryProfiler::statistics() const
+{
+  QMutexLocker locker(&m_mutex);
+  return m_statistics;
+}
+
+void core::QueryProfiler::clear()
+{
+  QMutexLocker locker(&m_mutex);
+  m_statistics.clear();
+}
+
+QStringList core::QueryProfiler::report() const
+{
+  std::map<QString, Statistics> stats = statistics();
+
+  // most expensive first
+  std::vector<std::pair<QString, Statistics> > sorted(stats.begin(), stats.end());
+  std::sort(sorted.begin(), sorted.end(), [](const std::pair<QString, Statistics> & a, const std::pair<QString, Statistics> & b)
+  {
+    return a.second.time > b.second.time;
+  });
+
+  QStringList result;
+  result << QString("%1 query templates profiled").arg(sorted.size());
+
+  // table -> (templates, executions, time, columns sqlite had to index)
+  struct TableUsage
+  {
+    TableUsage() : templates(0), executions(0), time(0) {}
+
+    unsigned int templates;
+    unsigned int executions;
+    qint64 time;
+    std::set<QString> columns;
+  };
+
+  std::map<QString, TableUsage> tables;
+
+  // index -> (templates, executions, time, templates answered from index only)
+  struct IndexUsage
+  {
+    IndexUsage() : templates(0), executions(0), time(0), covering(0) {}
+
+    unsigned int templates;
+    unsigned int executions;
+    qint64 time;
+    unsigned int covering;
+  };
+
+  std::map<QString, IndexUsage> indexes;
+
+  for (auto & it : sorted)
+  {
+    const Statistics & s = it.second;
+
+    result << QString("%1 executions, %2 ms, p50 %3 us, p99 %4 us, %5 rows (%6 per execution)%7 : %8")
+              .arg(s.executions)
+              .arg(s.time / 1000000.0, 0, 'f', 2)
+              .arg(s.percentile(0.5) / 1000)
+              .arg(s.percentile(0.99) / 1000)
+              .arg(s.rows)
+              .arg((double)s.rows / std::max(s.executions, 1u), 0, 'f', 1)
+              .arg(s.fullScanSteps ? QString(", %1 full scan steps").arg(s.fullScanSteps) : QString())
+              .arg(it.first);
+
+    std::map<QString, bool> usedIndexes;
+
+    for (const QString & detail : s.plan)
+    {
+      result << "    " + detail;
+
+      bool covering = false;
+      QString index = indexName(detail, covering);
+      if (!index.isEmpty())
+        usedIndexes[index] = covering;
+    }
+
+    for (auto & index : usedIndexes)
+    {
+      IndexUsage & usage = indexes[index.first];
+      usage.templates++;
+      usage.executions += s.executions;
+      usage.time += s.time;
+      if (index.second)
+        usage.covering++;
+    }
+
+    std::set<QString> usedTables;
+
+    for (const QString & table : s.scannedTables)
+      usedTables.insert(table);
+
+    for (const QString & index : s.automaticIndexes)
+    {
+      QString table = index.left(index.indexOf('('));
+      usedTables.insert(table);
+
+      for (const QString & column : index.mid(table.size() + 1, index.size() - table.size() - 2).split(",", QString::SkipEmptyParts))
+        tables[table].columns.insert(column);
+    }
+
+    for (const QString & table : usedTables)
+    {
+      TableUsage & usage = tables[table];
+      usage.templates++;
+      usage.executions += s.executions;
+      usage.time += s.time;
+    }
+  }
+
+  if (!indexes.empty())
+  {
+    result << "Indexes used :";
+
+    for (auto & it : indexes)
+    {
+      result << QString("    %1 : %2 query templates (%3 executions, %4 ms), covering for %5 of them")
+                .arg(it.first)
+                .arg(it.second.templates)
+                .arg(it.second.executions)
+                .arg(it.second.time / 1000000.0, 0, 'f', 2)
+                .arg(it.second.covering);
+    }
+  }
+
+  if (tables.empty())
+  {
+    result << "No table read without index";
+    return result;
+  }
+
+  std::vector<std::pair<QString, TableUsage> > sortedTables(tables.begin(), tables.end());
+  std::sort(sortedTables.begin(), sortedTables.end(), [](const std::pair<QString, TableUsage> & a, const std::pair<QString, TableUsage> & b)
+  {
+    return a.second.time > b.second.time;
+  });
+
+  result << "Tables that need an index in database.xml :";
+
+  for (auto & it : sortedTables)
+  {
+    const TableUsage & usage = it.second;
+
+    QString advice;
+    if (usage.columns.empty())
+    {
+      advice = "add createIndex=\"yes\" on fields filtered or joined by these queries";
+    }
+    else
+    {
+      QStringList columns;
+      for (const QString & column : usage.columns)
+        columns << column;
+      advice = QString("add createIndex=\"yes\" on %1").arg(columns.join(", "));
+    }
+
+    result << QString("    %1 : read without index by %2 query templates (%3 executions, %4 ms) - %5")
+              .arg(it.first)
+              .arg(usage.templates)
+              .arg(usage.executions)
+              .arg(usage.time / 1000000.0, 0, 'f', 2)
+              .arg(advice);
+  }
+
+  return result;
+}
+
+void core::QueryProfiler::logReport() const
+{
+  for (const QString & line : report())
+    LOG_INFO << line;
+}
+
+bool core::QueryProfiler::writeReport(const QString & file) const
+{
+  QFile f(file);
+  if (!f.open(QIODevice::WriteOnly | QIODevice::Text))
+  {
+    LOG_ERROR << "Fail to open" << file;
+    return false;
+  }
+
+  QTextStream out(&f);
+  for (const QString & line : report())
+    out << line << "\n";
+
+  return true;
+}
@@ -0,0 +1,107 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+/*
+* QueryProfiler.h
+*
+*  Created on: 18 Oct 2026
+*  Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+*/
+
+#ifndef _QUERYPROFILER_H_
+#define _QUERYPROFILER_H_
+
+#include <map>
+#include <vector>
+
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+#include "sqlite3.h"
+
+#ifdef _WIN32
+#    ifdef BUILDING_CORE_DLL
+#        define _QUERYPROFILER_API_ __declspec(dllexport)
+#    else
+#        define _QUERYPROFILER_API_ __declspec(dllimport)
+#    endif
+#else
+#    define _QUERYPROFILER_API_
+#endif
+
+namespace core
+{
+  // Statistics of sql queries run through SqlQuery, grouped by template : literal values are
+  // normalized out, so that queries only differing by their parameters are counted together.
+  // Query plan of each new template is captured, to point out tables read without index.
+  // Disabled unless enable() is called (Unofficial/ProfileQueries setting). Thread safe.
+  class _QUERYPROFILER_API_ QueryProfiler
+  {
+    public:
+      struct Statistics
+      {
+        Statistics();
+
+        unsigned int executions;
+        qint64 rows;
+        qint64 time; // ns, all executions
+        qint64 fullScanSteps; // rows stepped through by full table scans, as counted by sqlite
+        std::vector<unsigned int> histogram; // executions by log scale time bucket, see percentile()
+
+        QStringList plan; // EXPLAIN QUERY PLAN details
+        QStringList scannedTables; // tables scanned without index according to plan
+        QStringList automaticIndexes; // "table(column,...)" sqlite has to index on each run
+
+        // ns, upper bound of the histogram bucket holding given fraction (0-1) of executions
+        qint64 percentile(double fraction) const;
+      };
+
+      QueryProfiler() {}
+
+      static void enable() { s_enabled = true; }
+      static bool isEnabled() { return s_enabled; }
+
+      // literals replaced by '?', lists of them by a single one, whitespaces collapsed
+      static QString normalize(const QString & query);
+
+      // account one execution of query, plan is computed on db the first time template is seen
+      void record(sqlite3 * db, const QString & query, qint64 time, unsigned int rows, unsigned int fullScanSteps);
+
+      std::map<QString, Statistics> statistics() const;
+      void clear();
+
+      // templates by total time, indexes they use, then tables that need an index in database.xml
+      QStringList report() const;
+      void logReport() const;
+      bool writeReport(const QString & file) const;
+
+    private:
+      QueryProfiler(const QueryProfiler &);
+      void operator=(const QueryProfiler &);
+
+      static void explain(sqlite3 * db, const QString & query, Statistics & stats);
+
+      static bool s_enabled;
+
+      mutable QMutex m_mutex;
+      std::map<QString, Statistics> m_statistics;
+  };
+}
+
+#endif /* _QUERYPROFILER_H_ */
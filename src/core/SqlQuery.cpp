@@ -0,0 +1,254 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+/*
+* SqlQuery.cpp
+*
+*  Created on: 18 Oct 2026
+*  Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+*/
+
+#include "SqlQuery.h"
+
+#include <QElapsedTimer>
+
+#include "QueryProfiler.h"
+#include "StatementCache.h"
+#include "logger/Logger.h"
+
+core::SqlQuery::SqlQuery()
+  : m_db(0), m_statement(0), m_cache(0), m_profiler(0), m_error(false), m_running(false), m_executions(0), m_time(0),
+    m_executionTime(0), m_rows(0)
+{
+}
+
+core::SqlQuery::SqlQuery(sqlite3 * db, const QString & query, QueryProfiler * profiler)
+  : m_db(db), m_statement(0), m_cache(0), m_profiler(profiler), m_query(query), m_error(false), m_running(false),
+    m_executions(0), m_time(0), m_executionTime(0), m_rows(0)
+{
+  if (sqlite3_prepare_v2(m_db, query.toUtf8().constData(), -1, &m_statement, 0) != SQLITE_OK)
+  {
+    LOG_ERROR << "Preparing query" << query;
+    LOG_ERROR << "SQL error:" << sqlite3_errmsg(m_db);
+    sqlite3_finalize(m_statement);
+    m_statement = 0;
+    m_error = true;
+  }
+}
+
+core::SqlQuery::SqlQuery(sqlite3 * db, StatementCache * cache, const QString & query, QueryProfiler * profiler)
+  : m_db(db), m_statement(0), m_cache(cache), m_profiler(profiler), m_query(query), m_error(false), m_running(false),
+    m_executions(0), m_time(0), m_executionTime(0), m_rows(0)
+{
+  m_statement = m_cache->acquire(m_db, m_query);
+  m_error = (m_statement == 0);
+}
+
+core::SqlQuery::SqlQuery(SqlQuery && other)
+  : m_db(other.m_db), m_statement(other.m_statement), m_cache(other.m_cache), m_profiler(other.m_profiler), m_query(other.m_query),
+    m_error(other.m_error), m_running(other.m_running), m_executions(other.m_executions), m_time(other.m_time),
+    m_executionTime(other.m_executionTime), m_rows(other.m_rows)
+{
+  other.m_statement = 0;
+  other.m_cache = 0;
+  other.m_running = false;
+}
+
+core::SqlQuery::~SqlQuery()
+{
+  release();
+}
+
+core::SqlQuery & core::SqlQuery::operator=(SqlQuery && other)
+{
+  if (this != &other)
+  {
+    release();
+    m_db = other.m_db;
+    m_statement = other.m_statement;
+    m_cache = other.m_cache;
+    m_profiler = other.m_profiler;
+    m_query = other.m_query;
+    m_error = other.m_error;
+    m_running = other.m_running;
+    m_executions = other.m_executions;
+    m_time = other.m_time;
+    m_executionTime = other.m_executionTime;
+    m_rows = other.m_rows;
+    other.m_statement = 0;
+    other.m_cache = 0;
+    other.m_running = false;
+  }
+  return *this;
+}
+
+void core::SqlQuery::release()
+{
+  finishExecution();
+
+  if (m_cache)
+    m_cache->release(m_query, m_statement, m_executions, m_time);
+  else
+    sqlite3_finalize(m_statement);
+
+  m_statement = 0;
+  m_cache = 0;
+}
+
+void core::SqlQuery::bind(int index, int value)
+{
+  sqlite3_bind_int(m_statement, index, value);
+}
+
+void core::SqlQuery::bind(int index, qint64 value)
+{
+  sqlite3_bind_int64(m_statement, index, value);
+}
+
+void core::SqlQuery::bind(int index, double value)
+{
+  sqlite3_bind_double(m_statement, index, value);
+}
+
+void core::SqlQuery::bind(int index, const QString & value)
+{
+  QByteArray utf8 = value.toUtf8();
+  sqlite3_bind_text(m_statement, index, utf8.constData(), utf8.size(), SQLITE_TRANSIENT);
+}
+
+void core::SqlQuery::bind(int index, const QVariant & value)
+{
+  switch (value.type())
+  {
+    case QVariant::Invalid:
+      sqlite3_bind_null(m_statement, index);
+      break;
+    case QVariant::Bool:
+    case QVariant::Int:
+    case QVariant::UInt:
+    case QVariant::LongLong:
+    case QVariant::ULongLong:
+      bind(index, value.toLongLong());
+      break;
+    case QVariant::Double:
+      bind(index, value.toDouble());
+      break;
+    default:
+      bind(index, value.toString());
+      break;
+  }
+}
+
+bool core::SqlQuery::next()
+{
+  if (!m_statement)
+    return false;
+
+  if (!m_running)
+  {
+    m_running = true;
+    m_executions++;
+    m_executionTime = 0;
+    m_rows = 0;
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+  int rc = sqlite3_step(m_statement);
+  qint64 elapsed = timer.nsecsElapsed();
+  m_time += elapsed;
+  m_executionTime += elapsed;
+
+  if (rc == SQLITE_ROW)
+  {
+    m_rows++;
+    return true;
+  }
+
+  finishExecution();
+
+  if (rc != SQLITE_DONE)
+  {
+    LOG_ERROR << "Querying in database" << m_query;
+    LOG_ERROR << "SQL error:" << sqlite3_errmsg(m_db);
+    m_error = true;
+  }
+
+  return false;
+}
+
+bool core::SqlQuery::exec()
+{
+  next();
+  return isValid() && !m_error;
+}
+
+void core::SqlQuery::reset()
+{
+  finishExecution();
+  sqlite3_reset(m_statement);
+  m_error = false;
+}
+
+void core::SqlQuery::finishExecution()
+{
+  if (!m_running)
+    return;
+
+  m_running = false;
+
+  if (m_profiler)
+    m_profiler->record(m_db, m_query, m_executionTime, m_rows, sqlite3_stmt_status(m_statement, SQLITE_STMTSTATUS_FULLSCAN_STEP, 1));
+}
+
+int core::SqlQuery::columnCount() const
+{
+  return sqlite3_column_count(m_statement);
+}
+
+bool core::SqlQuery::isNull(int column) const
+{
+  return sqlite3_column_type(m_statement, column) == SQLITE_NULL;
+}
+
+int core::SqlQuery::integer(int column) const
+{
+  return sqlite3_column_int(m_statement, column);
+}
+
+qint64 core::SqlQuery::int64(int column) const
+{
+  return sqlite3_column_int64(m_statement, column);
+}
+
+double core::SqlQuery::real(int column) const
+{
+  return sqlite3_column_double(m_statement, column);
+}
+
+QString core::SqlQuery::text(int column) const
+{
+  const char * value = reinterpret_cast<const char *>(sqlite3_column_text(m_statement, column));
+  return QString::fromUtf8(value, sqlite3_column_bytes(m_statement, column));
+}
+
+QByteArray core::SqlQuery::textView(int column) const
+{
+  const char * value = reinterpret_cast<const char *>(sqlite3_column_text(m_statement, column));
+  return QByteArray::fromRawData(value, sqlite3_column_bytes(m_statement, column));
+}
@@ -0,0 +1,123 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+/*
+* SqlQuery.h
+*
+*  Created on: 18 Oct 2026
+*  Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+*/
+
+#ifndef _SQLQUERY_H_
+#define _SQLQUERY_H_
+
+#include <QByteArray>
+#include <QString>
+#include <QVariant>
+
+#include "sqlite3.h"
+
+#ifdef _WIN32
+#    ifdef BUILDING_CORE_DLL
+#        define _SQLQUERY_API_ __declspec(dllexport)
+#    else
+#        define _SQLQUERY_API_ __declspec(dllimport)
+#    endif
+#else
+#    define _SQLQUERY_API_
+#endif
+
+namespace core
+{
+  // Prepared sql statement, with bound parameters, read through a forward only cursor :
+  //
+  //   SqlQuery q = GAMEDATABASE.prepare("SELECT ID, Name FROM Creature WHERE ID = ?");
+  //   q.bind(1, id);
+  //   while (q.next())
+  //     doSomething(q.integer(0), q.text(1));
+  //
+  // Columns are read typed straight from sqlite, without any intermediate string.
+  // A query built from a StatementCache gives its statement back to the cache when destroyed,
+  // instead of finalizing it. Each execution is accounted to QueryProfiler, if any.
+  class QueryProfiler;
+  class StatementCache;
+
+  class _SQLQUERY_API_ SqlQuery
+  {
+    public:
+      SqlQuery();
+      SqlQuery(sqlite3 * db, const QString & query, QueryProfiler * profiler = 0);
+      SqlQuery(sqlite3 * db, StatementCache * cache, const QString & query, QueryProfiler * profiler = 0);
+      SqlQuery(SqlQuery && other);
+      ~SqlQuery();
+
+      SqlQuery & operator=(SqlQuery && other);
+
+      bool isValid() const { return m_statement != 0; }
+      QString query() const { return m_query; }
+
+      // parameters indexes start at 1, as in sql
+      void bind(int index, int value);
+      void bind(int index, qint64 value);
+      void bind(int index, double value);
+      void bind(int index, const QString & value);
+      // numeric variants are bound as integer or real, invalid ones as null, others as text
+      void bind(int index, const QVariant & value);
+
+      // move to next row. Returns false at end of results or on error (see hasError)
+      bool next();
+      // run a statement without result
+      bool exec();
+      // rewind statement, so that it can be run again (with new parameters)
+      void reset();
+
+      bool hasError() const { return m_error; }
+
+      // current row access, columns indexes start at 0
+      int columnCount() const;
+      bool isNull(int column) const;
+      int integer(int column) const;
+      qint64 int64(int column) const;
+      double real(int column) const;
+      QString text(int column) const;
+      // points into sqlite memory, no copy is made. Valid until next call to next() or reset()
+      QByteArray textView(int column) const;
+
+    private:
+      SqlQuery(const SqlQuery &);
+      SqlQuery & operator=(const SqlQuery &);
+
+      void release();
+      // end of current execution (all rows read, or statement reset before)
+      void finishExecution();
+
+      sqlite3 * m_db;
+      sqlite3_stmt * m_statement;
+      StatementCache * m_cache;
+      QueryProfiler * m_profiler;
+      QString m_query;
+      bool m_error;
+      bool m_running; // stepped since last reset
+      unsigned int m_executions;
+      qint64 m_time; // ns
+      qint64 m_executionTime; // ns, current execution
+      unsigned int m_rows; // current execution
+  };
+}
+
+#endif /* _SQLQUERY_H_ */
@@ -0,0 +1,123 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+/*
+* StatementCache.cpp
+*
+*  Created on: 18 Oct 2026
+*  Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+*/
+
+#include "StatementCache.h"
+
+#include <algorithm>
+
+#include <QMutexLocker>
+
+#include "logger/Logger.h"
+
+core::StatementCache::~StatementCache()
+{
+  clear();
+}
+
+sqlite3_stmt * core::StatementCache::acquire(sqlite3 * db, const QString & query)
+{
+  QMutexLocker locker(&m_mutex);
+
+  Entry & entry = m_entries[query];
+
+  if (!entry.statements.empty())
+  {
+    sqlite3_stmt * result = entry.statements.back();
+    entry.statements.pop_back();
+    entry.statistics.reuses++;
+    return result;
+  }
+
+  sqlite3_stmt * result = 0;
+  if (sqlite3_prepare_v2(db, query.toUtf8().constData(), -1, &result, 0) != SQLITE_OK)
+  {
+    LOG_ERROR << "Preparing query" << query;
+    LOG_ERROR << "SQL error:" << sqlite3_errmsg(db);
+    sqlite3_finalize(result);
+    return 0;
+  }
+
+  entry.statistics.prepares++;
+  return result;
+}
+
+void core::StatementCache::release(const QString & query, sqlite3_stmt * statement, unsigned int executions, qint64 time)
+{
+  if (statement)
+  {
+    sqlite3_reset(statement);
+    sqlite3_clear_bindings(statement);
+  }
+
+  QMutexLocker locker(&m_mutex);
+
+  Entry & entry = m_entries[query];
+  entry.statistics.executions += executions;
+  entry.statistics.time += time;
+
+  if (statement)
+    entry.statements.push_back(statement);
+}
+
+std::map<QString, core::StatementCache::Statistics> core::StatementCache::statistics() const
+{
+  QMutexLocker locker(&m_mutex);
+
+  std::map<QString, Statistics> result;
+  for (auto & it : m_entries)
+    result[it.first] = it.second.statistics;
+
+  return result;
+}
+
+void core::StatementCache::logStatistics() const
+{
+  std::map<QString, Statistics> stats = statistics();
+
+  // most expensive first
+  std::vector<std::pair<QString, Statistics> > sorted(stats.begin(), stats.end());
+  std::sort(sorted.begin(), sorted.end(), [](const std::pair<QString, Statistics> & a, const std::pair<QString, Statistics> & b)
+  {
+    return a.second.time > b.second.time;
+  });
+
+  for (auto & it : sorted)
+  {
+    LOG_INFO << "Query" << it.first << ":" << it.second.executions << "executions in" << it.second.time / 1000000 << "ms,"
+             << it.second.prepares << "prepared," << it.second.reuses << "reused";
+  }
+}
+
+void core::StatementCache::clear()
+{
+  QMutexLocker locker(&m_mutex);
+
+  for (auto & it : m_entries)
+  {
+    for (auto statement : it.second.statements)
+      sqlite3_finalize(statement);
+    it.second.statements.clear();
+  }
+}
@@ -0,0 +1,94 @@
+/*----------------------------------------------------------------------*\
+| This file is part of WoW Model Viewer                                  |
+|                                                                        |
+| WoW Model Viewer is free software: you can redistribute it and/or      |
+| modify it under the terms of the GNU General Public License as         |
+| published by the Free Software Foundation, either version 3 of the     |
+| License, or (at your option) any later version.                        |
+|                                                                        |
+| WoW Model Viewer is distributed in the hope that it will be useful,    |
+| but WITHOUT ANY WARRANTY; without even the implied warranty of         |
+| MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          |
+| GNU General Public License for more details.                           |
+|                                                                        |
+| You should have received a copy of the GNU General Public License      |
+| along with WoW Model Viewer.                                           |
+| If not, see <http://www.gnu.org/licenses/>.                            |
+\*----------------------------------------------------------------------*/
+
+/*
+* StatementCache.h
+*
+*  Created on: 18 Oct 2026
+*  Copyright: 2026 , WoW Model Viewer (http://wowmodelviewer.net)
+*/
+
+#ifndef _STATEMENTCACHE_H_
+#define _STATEMENTCACHE_H_
+
+#include <map>
+#include <vector>
+
+#include <QMutex>
+#include <QString>
+
+#include "sqlite3.h"
+
+#ifdef _WIN32
+#    ifdef BUILDING_CORE_DLL
+#        define _STATEMENTCACHE_API_ __declspec(dllexport)
+#    else
+#        define _STATEMENTCACHE_API_ __declspec(dllimport)
+#    endif
+#else
+#    define _STATEMENTCACHE_API_
+#endif
+
+namespace core
+{
+  // Prepared statements kept by query template, so that a query run many times with different
+  // parameters is parsed and planned once. A statement is used by one query at a time : it is
+  // taken from cache (or prepared if none is free) and given back once query is done with it.
+  // Thread safe.
+  class _STATEMENTCACHE_API_ StatementCache
+  {
+    public:
+      struct Statistics
+      {
+        Statistics() : executions(0), prepares(0), reuses(0), time(0) {}
+
+        unsigned int executions;
+        unsigned int prepares; // statements actually prepared
+        unsigned int reuses; // statements taken back from cache (plan reuse)
+        qint64 time; // ns spent running statements
+      };
+
+      StatementCache() {}
+      ~StatementCache();
+
+      // return 0 if query can't be prepared
+      sqlite3_stmt * acquire(sqlite3 * db, const QString & query);
+      void release(const QString & query, sqlite3_stmt * statement, unsigned int executions, qint64 time);
+
+      std::map<QString, Statistics> statistics() const;
+      void logStatistics() const;
+
+      // finalize all statements, must be called before closing database
+      void clear();
+
+    private:
+      StatementCache(const StatementCache &);
+      void operator=(const StatementCache &);
+
+      struct Entry
+      {
+        std::vector<sqlite3_stmt *> statements; // free ones
+        Statistics statistics;
+      };
+
+      mutable QMutex m_mutex;
+      std::map<QString, Entry> m_entries;
+  };
+}
+
+#endif /* _STATEMENTCACHE_H_ */
@@ -1,15 +1,122 @@
 #include "dbfile.h"
 
+#include <algorithm>
+#include <cstdlib> // strtoll, strtod
+
+#include <QByteArray>
+
 #include "logger/Logger.h"
 
+void DBStringWriter::writeInt(qint64 value)
+{
+  m_values.push_back(std::to_string(value));
+}
+
+void DBStringWriter::writeReal(double value)
+{
+  m_values.push_back(QByteArray::number(value, 'g', 6).toStdString());
+}
+
+void DBStringWriter::writeText(const char * value, int size)
+{
+  std::string text(value, size);
+  std::replace(text.begin(), text.end(), '"', '\'');
+  m_values.push_back(text);
+}
+
 DBFile::DBFile() :
   data(0),
   stringTable(0),
   recordSize(0),
   recordCount(0),
   fieldCount(0),
-  stringSize(0)
+  stringSize(0),
+  m_minId(0),
+  m_hashMask(0)
+{
+}
+
+const unsigned int DBFile::npos;
+
+namespace
+{
+  inline unsigned int hashId(unsigned int id)
+  {
+    id ^= id >> 16;
+    id *= 0x45d9f3b;
+    id ^= id >> 16;
+    return id;
+  }
+}
+
+void DBFile::setRecordIds(const std::vector<unsigned int> & ids)
+{
+  m_denseIds.clear();
+  m_hashedIds.clear();
+
+  if (ids.empty())
+    return;
+
+  auto minmax = std::minmax_element(ids.begin(), ids.end());
+  m_minId = *minmax.first;
+
+  // a dense slot costs 4 bytes per possible id, a hashed one 8 bytes per record at half load
+  unsigned long long range = (unsigned long long)*minmax.second - m_minId + 1;
+  if (range <= 4 * (unsigned long long)ids.size() + 1024)
+  {
+    m_denseIds.assign((size_t)range, npos);
+
+    for (unsigned int i = 0; i < ids.size(); i++)
+    {
+      unsigned int & slot = m_denseIds[ids[i] - m_minId];
+      if (slot == npos)
+        slot = i;
+    }
+  }
+  else
+  {
+    size_t size = 1;
+    while (size < 2 * ids.size())
+      size <<= 1;
+
+    m_hashedIds.assign(size, std::make_pair(0u, npos));
+    m_hashMask = (unsigned int)(size - 1);
+
+    for (unsigned int i = 0; i < ids.size(); i++)
+    {
+      unsigned int pos = hashId(ids[i]) & m_hashMask;
+      while (m_hashedIds[pos].second != npos && m_hashedIds[pos].first != ids[i])
+        pos = (pos + 1) & m_hashMask;
+
+      if (m_hashedIds[pos].second == npos)
+        m_hashedIds[pos] = std::make_pair(ids[i], i);
+    }
+  }
+}
+
+unsigned int DBFile::findById(unsigned int id) const
 {
+  if (!m_denseIds.empty())
+  {
+    if (id < m_minId || id - m_minId >= m_denseIds.size())
+      return npos;
+
+    return m_denseIds[id - m_minId];
+  }
+
+  if (m_hashedIds.empty())
+    return npos;
+
+  unsigned int pos = hashId(id) & m_hashMask;
+  while (m_hashedIds[pos].second != npos)
+  {
+    if (m_hashedIds[pos].first == id)
+      return m_hashedIds[pos].second;
+
+    pos = (pos + 1) & m_hashMask;
+  }
+
+  return npos;
 }
 
 DBFile::Iterator DBFile::begin()
@@ -21,3 +128,31 @@ DBFile::Iterator DBFile::end()
 	return Iterator(*this, recordCount);
 }
 
+
+void DBFile::decodeRange(unsigned int begin, unsigned int end, const core::TableStructure * structure, DBRecordWriter & writer) const
+{
+  for (unsigned int record = begin; record < end; record++)
+  {
+    writer.beginRecord(record);
+    writeRecord(record, structure, writer);
+  }
+}
+
+void DBFile::writeRecord(unsigned int recordIndex, const core::TableStructure * structure, DBRecordWriter & writer) const
+{
+  std::vector<std::string> values = get(recordIndex, structure);
+  std::vector<std::string>::const_iterator value = values.begin();
+
+  for (auto it : structure->fields)
+  {
+    for (unsigned int i = 0; i < it->arraySize && value != values.end(); i++, ++value)
+    {
+      if (it->type == "text")
+        writer.writeText(value->c_str(), (int)value->size());
+      else if (it->type == "float")
+        writer.writeReal(strtod(value->c_str(), 0));
+      else
+        writer.writeInt(strtoll(value->c_str(), 0, 10));
+    }
+  }
+}
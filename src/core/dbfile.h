@@ -7,6 +7,7 @@
 #include <vector>
 
 #include <QString>
+#include <QtGlobal>
 
 #include "GameDatabase.h"
 
@@ -21,9 +22,39 @@
 #endif
 
 
+// receives typed values of a record, one call per column, in table column order
+class _DBFILE_API_ DBRecordWriter
+{
+public:
+  virtual ~DBRecordWriter() {}
+
+  // called by DBFile::decodeRange before values of each record
+  virtual void beginRecord(unsigned int /* recordIndex */) {}
+
+  virtual void writeInt(qint64 value) = 0;
+  virtual void writeReal(double value) = 0;
+  virtual void writeText(const char * value, int size) = 0;
+};
+
+// values converted to strings, to implement DBFile::get on top of a typed decoder
+class _DBFILE_API_ DBStringWriter : public DBRecordWriter
+{
+public:
+  explicit DBStringWriter(std::vector<std::string> & values) : m_values(values) {}
+
+  void writeInt(qint64 value);
+  void writeReal(double value);
+  void writeText(const char * value, int size);
+
+private:
+  std::vector<std::string> & m_values;
+};
+
 class _DBFILE_API_ DBFile
 {
 public:
+  static const unsigned int npos = 0xFFFFFFFF;
+
   explicit DBFile();
   virtual ~DBFile() {};
 
@@ -74,10 +105,24 @@ public:
 	/// Trivial
 	size_t getRecordCount() const { return recordCount; }
 
+  // index of record with given id (copied records included), npos if none. Available once file is opened
+  unsigned int findById(unsigned int id) const;
+
   // to be implemented in inherited classes to get actual record values (specified by recordOffset), following "structure" format
   virtual std::vector<std::string> get(unsigned int recordIndex, const core::TableStructure * structure) const = 0;
 
+  // same as get, but values are given typed to writer instead of being converted to strings.
+  // Default implementation converts get() result back, override it to read values directly
+  virtual void writeRecord(unsigned int recordIndex, const core::TableStructure * structure, DBRecordWriter & writer) const;
+
+  // decode records [begin, end) to writer. Default implementation calls writeRecord for each record,
+  // override it to decode a whole range in one go
+  virtual void decodeRange(unsigned int begin, unsigned int end, const core::TableStructure * structure, DBRecordWriter & writer) const;
+
 protected:
+  // ids of records, in record order, to be given by inherited classes when opening file
+  void setRecordIds(const std::vector<unsigned int> & ids);
+
 	size_t recordSize;
 	size_t recordCount;
 	size_t fieldCount;
@@ -88,6 +133,12 @@ protected:
   private:
   DBFile(const DBFile &);
   void operator=(const DBFile &);
+
+  // id -> record index : dense array when ids are compact enough, open addressing hash otherwise
+  unsigned int m_minId;
+  std::vector<unsigned int> m_denseIds;
+  std::vector<std::pair<unsigned int, unsigned int> > m_hashedIds; // (id, record), record is npos for empty slots
+  unsigned int m_hashMask;
 };
 
 #endif
@@ -13,76 +13,76 @@
 #include "logger/Logger.h"
 // #define DEBUG_READ
 
-std::vector<std::string> KNOWN_CHUNKS =
+std::vector<unsigned int> KNOWN_CHUNKS =
 {
-  "PFID",
-  "SFID",
-  "AFID",
-  "BFID",
-  "MD21",
-  "TXAC",
-  "EXPT",
-  "EXP2",
-  "PABC",
-  "PADC",
-  "PSBC",
-  "PEDC",
-  "SKID",
-  "AFM2",
-  "AFSA",
-  "AFSB",
-  "SKL1",
-  "SKA1",
-  "SKB1",
-  "SKS1",
-  "SKPD"
+  core::fourcc("PFID"),
+  core::fourcc("SFID"),
+  core::fourcc("AFID"),
+  core::fourcc("BFID"),
+  core::fourcc("MD21"),
+  core::fourcc("TXAC"),
+  core::fourcc("EXPT"),
+  core::fourcc("EXP2"),
+  core::fourcc("PABC"),
+  core::fourcc("PADC"),
+  core::fourcc("PSBC"),
+  core::fourcc("PEDC"),
+  core::fourcc("SKID"),
+  core::fourcc("AFM2"),
+  core::fourcc("AFSA"),
+  core::fourcc("AFSB"),
+  core::fourcc("SKL1"),
+  core::fourcc("SKA1"),
+  core::fourcc("SKB1"),
+  core::fourcc("SKS1"),
+  core::fourcc("SKPD")
   /*
-  "MOHD",
-  "MOTX",
-  "MOMT",
-  "MOUV",
-  "MOGN",
-  "MOGI",
-  "MOSB",
-  "MOPV",
-  "MOPT",
-  "MOPR",
-  "MOVV",
-  "MOVB",
-  "MOLT",
-  "MODS",
-  "MODN",
-  "MODD",
-  "MFOG",
-  "MCVP",
-  "GFID",
-  "MOGP",
-  "MOPY",
-  "MOVI",
-  "MOVT",
-  "MONR",
-  "MOTV",
-  "MOBA",
-  "MOLR",
-  "MODR",
-  "MOBN",
-  "MOBR",
-  "MOCV",
-  "MLIQ",
-  "MORI",
-  "MORB",
-  "MOTA",
-  "MOBS",
-  "MDAL",
-  "MOPL",
-  "MOPB",
-  "MOLS",
-  "MOLP"
+  core::fourcc("MOHD"),
+  core::fourcc("MOTX"),
+  core::fourcc("MOMT"),
+  core::fourcc("MOUV"),
+  core::fourcc("MOGN"),
+  core::fourcc("MOGI"),
+  core::fourcc("MOSB"),
+  core::fourcc("MOPV"),
+  core::fourcc("MOPT"),
+  core::fourcc("MOPR"),
+  core::fourcc("MOVV"),
+  core::fourcc("MOVB"),
+  core::fourcc("MOLT"),
+  core::fourcc("MODS"),
+  core::fourcc("MODN"),
+  core::fourcc("MODD"),
+  core::fourcc("MFOG"),
+  core::fourcc("MCVP"),
+  core::fourcc("GFID"),
+  core::fourcc("MOGP"),
+  core::fourcc("MOPY"),
+  core::fourcc("MOVI"),
+  core::fourcc("MOVT"),
+  core::fourcc("MONR"),
+  core::fourcc("MOTV"),
+  core::fourcc("MOBA"),
+  core::fourcc("MOLR"),
+  core::fourcc("MODR"),
+  core::fourcc("MOBN"),
+  core::fourcc("MOBR"),
+  core::fourcc("MOCV"),
+  core::fourcc("MLIQ"),
+  core::fourcc("MORI"),
+  core::fourcc("MORB"),
+  core::fourcc("MOTA"),
+  core::fourcc("MOBS"),
+  core::fourcc("MDAL"),
+  core::fourcc("MOPL"),
+  core::fourcc("MOPB"),
+  core::fourcc("MOLS"),
+  core::fourcc("MOLP")
   */
 };
 
 CASCFile::CASCFile(QString path, int id)
-  : GameFile(path, id), m_handle(0)
+  : GameFile(path, id), m_handle(0), m_fromCache(false), m_cacheSize(0)
 {
 }
 
@@ -93,6 +93,23 @@ CASCFile::~CASCFile()
 
 bool  CASCFile::openFile()
 {
+  // reuse already decoded (or being prefetched) content if available
+  if (fileDataId() > 0)
+  {
+    core::GameFileBuffer cached;
+    unsigned int cachedSize = 0;
+
+    GAMEDIRECTORY.waitForPrefetch(fileDataId());
+
+    if (GAMEDIRECTORY.cache().get(fileDataId(), cached, cachedSize))
+    {
+      setSharedBuffer(cached, cachedSize);
+      m_fromCache = true;
+      m_cacheSize = cachedSize;
+      return true;
+    }
+  }
+
   if (!GAMEDIRECTORY.openFile(filepath.toStdString(), &m_handle))
   {
     LOG_ERROR << "Opening" << filepath << "failed." << "Error" << GetLastError();
@@ -104,7 +121,7 @@ bool  CASCFile::openFile()
 
 bool CASCFile::isAlreadyOpened()
 {
-  if (m_handle)
+  if (m_handle || m_fromCache)
     return true;
   else
     return false;
@@ -113,6 +130,12 @@ bool CASCFile::isAlreadyOpened()
 bool CASCFile::getFileSize(unsigned int & s)
 {
   bool result = false;
+
+  if (m_fromCache)
+  {
+    s = m_cacheSize;
+    return true;
+  }
   
   if (m_handle)
   {
@@ -130,49 +153,80 @@ bool CASCFile::getFileSize(unsigned int & s)
 unsigned long CASCFile::readFile()
 {
   unsigned long result = 0;
+
+  if (m_fromCache)
+    return m_cacheSize;
   
-  if (!CascReadFile(m_handle, buffer, size, &result))
+  if (!GAMEDIRECTORY.readFile(m_handle, buffer, size, &result))
     LOG_ERROR << "Reading" << filepath << "failed." << "Error" << GetLastError();
+  else if (result == size)
+    GAMEDIRECTORY.cache().put(fileDataId(), sharedBuffer(), size);
   
   return result;
 }
 
-void CASCFile::doPostOpenOperation()
+bool CASCFile::readFileRange(unsigned int offset, unsigned long & read)
 {
-  if (size >= sizeof(chunkHeader))
+  // custom files (see HardDriveFile) have no CASC handle
+  if (!m_handle)
+    return false;
+
+  read = 0;
+
+  if (!GAMEDIRECTORY.readFileRange(m_handle, offset, buffer, size, &read))
   {
-    chunkHeader chunkHead;
-    memcpy(&chunkHead, buffer, sizeof(chunkHeader));
-    std::string magic = std::string(chunkHead.magic, 4);
-    if (std::find(KNOWN_CHUNKS.begin(), KNOWN_CHUNKS.end(), magic) != KNOWN_CHUNKS.end() 
-        && chunkHead.size <= size)
-    {
-      unsigned int offset = 0;
+    LOG_ERROR << "Reading" << filepath << "from" << offset << "failed." << "Error" << GetLastError();
+    return false;
+  }
 
-      //LOG_INFO << "Parsing chunks for file" << filepath << "First chunk read :" << magic.c_str();
-      while (offset < size)
-      {
-        chunkHeader chunkHead;
-        memcpy(&chunkHead, buffer + offset, sizeof(chunkHeader));
-        offset += sizeof(chunkHeader);
+  // short read : let caller fall back to a whole file read
+  return (read == size);
+}
 
-        Chunk * chunk = new Chunk();
-        chunk->magic = std::string(chunkHead.magic, 4);
-        chunk->start = offset;
-        chunk->size = chunkHead.size;
-        chunk->pointer = 0;
-        chunks.push_back(*chunk);
+void CASCFile::doPostOpenOperation()
+{
+  buildChunks(buffer, size, chunks);
 
-        //LOG_INFO << "Chunk :" << chunk->magic.c_str() << chunk->start << chunk->size;
+  // if there is only one chunk, set it
+  if (chunks.size() == 1)
+    setChunk(chunks[0].magic);
+}
 
-        offset += chunkHead.size;
-      }
+void CASCFile::buildChunks(const unsigned char * content, unsigned int contentSize, core::ChunkDirectory & result)
+{
+  if (contentSize < sizeof(chunkHeader))
+    return;
 
-      // if there is only one chunk, set it
-      if (chunks.size() == 1)
-        setChunk(chunks[0].magic);
-    }
+  chunkHeader chunkHead;
+  memcpy(&chunkHead, content, sizeof(chunkHeader));
+  unsigned int magic;
+  memcpy(&magic, chunkHead.magic, 4);
+  if (std::find(KNOWN_CHUNKS.begin(), KNOWN_CHUNKS.end(), magic) != KNOWN_CHUNKS.end()
+      && chunkHead.size <= contentSize)
+  {
+    //LOG_INFO << "Parsing chunks for file" << filepath << "First chunk read :" << core::fourccName(magic).c_str();
+    result.build(content, 0, contentSize);
+  }
+}
+
+bool CASCFile::readContent(core::GameFileBuffer & content, unsigned int & contentSize)
+{
+  if (fileDataId() > 0)
+  {
+    GAMEDIRECTORY.waitForPrefetch(fileDataId());
+
+    if (GAMEDIRECTORY.cache().get(fileDataId(), content, contentSize))
+      return true;
   }
+
+  if (!GAMEDIRECTORY.decodeFile(this, content, contentSize))
+  {
+    LOG_ERROR << "Reading" << filepath << "failed." << "Error" << GetLastError();
+    return false;
+  }
+
+  GAMEDIRECTORY.cache().put(fileDataId(), content, contentSize);
+  return true;
 }
 
 bool CASCFile::doPostCloseOperation()
@@ -180,17 +234,20 @@ bool CASCFile::doPostCloseOperation()
 #ifdef DEBUG_READ
   LOG_INFO << this << __FUNCTION__ << "Closing" << filepath << "handle" << m_handle;
 #endif
+  m_fromCache = false;
+  m_cacheSize = 0;
+
   if(m_handle)
   {
     HANDLE savedHandle = m_handle;
     m_handle = 0;
 
 #ifdef DEBUG_READ
-    bool result = CascCloseFile(savedHandle);
+    bool result = GAMEDIRECTORY.closeFile(savedHandle);
     LOG_INFO << __FUNCTION__ << result;
     return result;
 #else
-    return CascCloseFile(savedHandle);
+    return GAMEDIRECTORY.closeFile(savedHandle);
 #endif
   }
 
@@ -202,46 +259,41 @@ void CASCFile::dumpStructure()
   LOG_INFO << "Structure for file" << filepath;
   for (auto it : chunks)
   {
-    if (it.magic == "AFID")
+    std::string name = core::fourccName(it.magic);
+
+    if (it.magic == core::fourcc("AFID"))
     {
-      LOG_INFO << "Chunk :" << it.magic.c_str() << "nb anim file id" << it.size / sizeof(AFID);
+      LOG_INFO << "Chunk :" << name.c_str() << "nb anim file id" << it.size / sizeof(AFID);
     }
-    else if (it.magic == "SKS1")
+    else if (it.magic == core::fourcc("SKS1"))
     {
-      setChunk("SKS1");
       SKS1 sks1;
-      read(&sks1, sizeof(sks1));
-      LOG_INFO << "Chunk :" << it.magic.c_str() << "nGlobalSequences" << sks1.nGlobalSequences << "nAnimations" << sks1.nAnimations << "nAnimationLookup" << sks1.nAnimationLookup;
+      if (chunk<SKS1>(it.magic).get(0, sks1))
+        LOG_INFO << "Chunk :" << name.c_str() << "nGlobalSequences" << sks1.nGlobalSequences << "nAnimations" << sks1.nAnimations << "nAnimationLookup" << sks1.nAnimationLookup;
     }
-    else if (it.magic == "SKA1")
+    else if (it.magic == core::fourcc("SKA1"))
     {
-      setChunk("SKA1");
       SKA1 ska1;
-      read(&ska1, sizeof(ska1));
-      LOG_INFO << "Chunk :" << it.magic.c_str() << "nAttachments" << ska1.nAttachments << "nAttachLookup" << ska1.nAttachLookup;
+      if (chunk<SKA1>(it.magic).get(0, ska1))
+        LOG_INFO << "Chunk :" << name.c_str() << "nAttachments" << ska1.nAttachments << "nAttachLookup" << ska1.nAttachLookup;
     }
-    else if (it.magic == "SKB1")
+    else if (it.magic == core::fourcc("SKB1"))
     {
-      setChunk("SKB1");
       SKB1 skb1;
-      read(&skb1, sizeof(skb1));
-      LOG_INFO << "Chunk :" << it.magic.c_str() << "nBones" << skb1.nBones << "nKeyBoneLookup" << skb1.nKeyBoneLookup;
+      if (chunk<SKB1>(it.magic).get(0, skb1))
+        LOG_INFO << "Chunk :" << name.c_str() << "nBones" << skb1.nBones << "nKeyBoneLookup" << skb1.nKeyBoneLookup;
     }
-    else if (it.magic == "SKPD")
+    else if (it.magic == core::fourcc("SKPD"))
     {
-      setChunk("SKPD");
       SKPD skpd;
-      read(&skpd, sizeof(skpd));
-      LOG_INFO << "Chunk :" << it.magic.c_str() << "parentFileId" << skpd.parentFileId;
+      if (chunk<SKPD>(it.magic).get(0, skpd))
+        LOG_INFO << "Chunk :" << name.c_str() << "parentFileId" << skpd.parentFileId;
     }
-    else if (it.magic == "BFID")
+    else if (it.magic == core::fourcc("BFID"))
     {
-      LOG_INFO << "Chunk :" << it.magic.c_str() << "nb bone files id" << it.size / sizeof(uint32);
-      setChunk("BFID");
-      while (!isEof())
+      LOG_INFO << "Chunk :" << name.c_str() << "nb bone files id" << it.size / sizeof(uint32);
+      for (auto id : chunk<uint32>(it.magic))
       {
-        uint32 id;
-        read(&id, sizeof(uint32));
         GameFile * f = GAMEDIRECTORY.getFile(id);
         if (f)
           LOG_INFO << f->fullname();
@@ -249,7 +301,7 @@ void CASCFile::dumpStructure()
     }
     else
     {
-      LOG_INFO << "Chunk :" << it.magic.c_str() << it.start << it.size;
+      LOG_INFO << "Chunk :" << name.c_str() << it.start << it.size;
     }
   }
 }
@@ -42,11 +42,16 @@ class _CASCFILE_API_ CASCFile : public GameFile
     virtual bool isAlreadyOpened();
     virtual bool getFileSize(unsigned int & s);
     virtual unsigned long readFile();
+    virtual bool readFileRange(unsigned int offset, unsigned long & read);
     virtual void doPostOpenOperation();
     virtual bool doPostCloseOperation();
+    virtual bool readContent(core::GameFileBuffer & content, unsigned int & contentSize);
+    virtual void buildChunks(const unsigned char * content, unsigned int contentSize, core::ChunkDirectory & chunks);
 
   private:
     HANDLE m_handle;
+    bool m_fromCache; // content grabbed from GAMEDIRECTORY cache, no CASC handle involved
+    unsigned int m_cacheSize; // whole file size when content comes from cache (size only covers current range / chunk)
 };
 
 
@@ -15,6 +15,7 @@
 #include <utility>
 
 #include <QFile>
+#include <QMutexLocker>
 #include <QRegularExpression>
 
 #include "CASCFile.h"
@@ -168,6 +169,7 @@ bool CASCFolder::fileExists(std::string file)
 
   HANDLE dummy;
 
+  QMutexLocker locker(&m_storageMutex);
   if(CascOpenFile(hStorage,file.c_str(), m_currentCascLocale, 0, &dummy))
   {
    // LOG_INFO << "OK";
@@ -181,17 +183,61 @@ bool CASCFolder::fileExists(std::string file)
 
 bool CASCFolder::openFile(std::string file, HANDLE * result)
 {
- 
+  QMutexLocker locker(&m_storageMutex);
   return CascOpenFile(hStorage,file.c_str(), m_currentCascLocale, 0, result);
 }
 
+bool CASCFolder::readFile(HANDLE file, unsigned char * buffer, unsigned int size, unsigned long * read)
+{
+  QMutexLocker locker(&m_storageMutex);
+
+  // whole file is read, whatever position previous partial reads (see readFileRange) left
+  if (CascSetFilePointer(file, 0, NULL, FILE_BEGIN) != 0)
+    return false;
+
+  return CascReadFile(file, buffer, size, read);
+}
+
+bool CASCFolder::readFileRange(HANDLE file, unsigned int offset, unsigned char * buffer, unsigned int size, unsigned long * read)
+{
+  QMutexLocker locker(&m_storageMutex);
+
+  if (CascSetFilePointer(file, offset, NULL, FILE_BEGIN) != offset)
+    return false;
+
+  return CascReadFile(file, buffer, size, read);
+}
+
 bool CASCFolder::closeFile(HANDLE file)
 {
+  QMutexLocker locker(&m_storageMutex);
   return CascCloseFile(file);
 }
 
+bool CASCFolder::decodeFile(std::string file, core::GameFileBuffer & buffer, unsigned int & size)
+{
+  HANDLE handle;
+  if (!openFile(file, &handle))
+    return false;
+
+  bool result = false;
+  size = CascGetFileSize(handle, 0);
+
+  if (size != CASC_INVALID_SIZE)
+  {
+    buffer.reset(new unsigned char[size], std::default_delete<unsigned char[]>());
+    unsigned long read = 0;
+    result = readFile(handle, buffer.get(), size, &read) && (read == size);
+  }
+
+  closeFile(handle);
+
+  return result;
+}
+
 int CASCFolder::fileDataId(std::string & filename)
 {
+  QMutexLocker locker(&m_storageMutex);
   return CascGetFileId(hStorage, filename.c_str());
 }
 
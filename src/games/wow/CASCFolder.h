@@ -20,6 +20,7 @@
 
 #include <iostream>
 
+#include <QMutex>
 #include <QString>
 
 #include "GameFolder.h" // GameConfig
@@ -52,8 +53,15 @@ class _CASCFOLDER_API_ CASCFolder
     bool fileExists(std::string file);
 
     bool openFile(std::string file, HANDLE * result);
+    bool readFile(HANDLE file, unsigned char * buffer, unsigned int size, unsigned long * read);
+    // only frames covering requested range are decoded by CascLib
+    bool readFileRange(HANDLE file, unsigned int offset, unsigned char * buffer, unsigned int size, unsigned long * read);
     bool closeFile(HANDLE file);
 
+    // open, read and close given file at once
+    bool decodeFile(std::string file, core::GameFileBuffer & buffer, unsigned int & size);
+
+    // lookup in storage root tables, serialized with other storage accesses
     int fileDataId(std::string & filename);
 
   private:
@@ -71,6 +79,10 @@ class _CASCFOLDER_API_ CASCFolder
     HANDLE hStorage;
 
     std::vector<core::GameConfig> m_configs;
+
+    // CascLib doesn't document storage accesses as thread safe : opening, reading and closing
+    // files, and looking up file data ids, are serialized on all platforms
+    QMutex m_storageMutex;
 };
 
 
@@ -265,7 +265,7 @@ std::vector<int> CharDetails::getTextureForSection(SectionType section)
   LOG_INFO << "----------------------------------------------";
   */
 
-  size_t type = section;
+  int type = section;
 
   if (infos.isHD && type != TatooType) // HD layout
     type += 5;
@@ -274,46 +274,47 @@ std::vector<int> CharDetails::getTextureForSection(SectionType section)
                           "LEFT JOIN TextureFileData AS TFD1 ON TextureName1 = TFD1.ID "
                           "LEFT JOIN TextureFileData AS TFD2 ON TextureName2 = TFD2.ID "
                           "LEFT JOIN TextureFileData AS TFD3 ON TextureName3 = TFD3.ID ");
+  QVariantList parameters;
   switch (section)
   {
     case SkinType:
     case UnderwearType:
-      query += QString("WHERE (RaceID=%1 AND SexID=%2 AND ColorIndex=%3 AND SectionType=%4)")
-        .arg(infos.raceid)
-        .arg(infos.sexid)
-        .arg(m_currentCustomization[SKIN_COLOR])
-        .arg(type);
+      query += "WHERE (RaceID=? AND SexID=? AND ColorIndex=? AND SectionType=?)";
+      parameters << infos.raceid
+                 << infos.sexid
+                 << m_currentCustomization[SKIN_COLOR]
+                 << type;
       break;
     case FaceType:
-      query += QString("WHERE (RaceID=%1 AND SexID=%2 AND ColorIndex=%3 AND VariationIndex=%4 AND SectionType=%5)")
-        .arg(infos.raceid)
-        .arg(infos.sexid)
-        .arg(m_currentCustomization[SKIN_COLOR])
-        .arg(m_currentCustomization[FACE])
-        .arg(type);
+      query += "WHERE (RaceID=? AND SexID=? AND ColorIndex=? AND VariationIndex=? AND SectionType=?)";
+      parameters << infos.raceid
+                 << infos.sexid
+                 << m_currentCustomization[SKIN_COLOR]
+                 << m_currentCustomization[FACE]
+                 << type;
       break;
     case HairType:
-      query += QString("WHERE (RaceID=%1 AND SexID=%2 AND VariationIndex=%3 AND ColorIndex=%4 AND SectionType=%5)")
-        .arg(infos.raceid)
-        .arg(infos.sexid)
-        .arg((m_currentCustomization[FACIAL_CUSTOMIZATION_STYLE] == 0) ? 1 : m_currentCustomization[FACIAL_CUSTOMIZATION_STYLE]) // quick fix for bald characters... VariationIndex = 0 returns no result
-        .arg(m_currentCustomization[FACIAL_CUSTOMIZATION_COLOR])
-        .arg(type);
+      query += "WHERE (RaceID=? AND SexID=? AND VariationIndex=? AND ColorIndex=? AND SectionType=?)";
+      parameters << infos.raceid
+                 << infos.sexid
+                 << ((m_currentCustomization[FACIAL_CUSTOMIZATION_STYLE] == 0) ? 1 : m_currentCustomization[FACIAL_CUSTOMIZATION_STYLE]) // quick fix for bald characters... VariationIndex = 0 returns no result
+                 << m_currentCustomization[FACIAL_CUSTOMIZATION_COLOR]
+                 << type;
       break;
     case FacialHairType:
-      query += QString("WHERE (RaceID=%1 AND SexID=%2 AND VariationIndex=%3 AND ColorIndex=%4 AND SectionType=%5)")
-        .arg(infos.raceid)
-        .arg(infos.sexid)
-        .arg(m_currentCustomization[ADDITIONAL_FACIAL_CUSTOMIZATION])
-        .arg(m_currentCustomization[FACIAL_CUSTOMIZATION_COLOR])
-        .arg(type);
+      query += "WHERE (RaceID=? AND SexID=? AND VariationIndex=? AND ColorIndex=? AND SectionType=?)";
+      parameters << infos.raceid
+                 << infos.sexid
+                 << m_currentCustomization[ADDITIONAL_FACIAL_CUSTOMIZATION]
+                 << m_currentCustomization[FACIAL_CUSTOMIZATION_COLOR]
+                 << type;
       break;
     case TatooType:
-      query += QString("WHERE (RaceID=%1 AND SexID=%2 AND VariationIndex=%3 AND SectionType=%4)")
-        .arg(infos.raceid)
-        .arg(infos.sexid)
-        .arg((m_customizationParamsMap[DH_TATTOO_STYLE].possibleValues.size() - 1) * m_currentCustomization[DH_TATTOO_COLOR] + m_currentCustomization[DH_TATTOO_STYLE])
-        .arg(type);
+      query += "WHERE (RaceID=? AND SexID=? AND VariationIndex=? AND SectionType=?)";
+      parameters << infos.raceid
+                 << infos.sexid
+                 << (int)((m_customizationParamsMap[DH_TATTOO_STYLE].possibleValues.size() - 1) * m_currentCustomization[DH_TATTOO_COLOR] + m_currentCustomization[DH_TATTOO_STYLE])
+                 << type;
       break;
     default:
       query = "";
@@ -321,7 +322,7 @@ std::vector<int> CharDetails::getTextureForSection(SectionType section)
 
   if (query != "")
   {
-    sqlResult vals = GAMEDATABASE.sqlQuery(query);
+    sqlResult vals = GAMEDATABASE.sqlQuery(query, parameters);
     if (vals.valid && !vals.values.empty())
     {
       for (size_t i = 0; i < vals.values[0].size(); i++)
@@ -360,12 +361,9 @@ void CharDetails::fillCustomizationMap()
   CustomizationParam skin;
   skin.name = "Skin";
 
-  QString query = QString("SELECT ColorIndex FROM CharSections WHERE RaceID=%1 AND SexID=%2 AND SectionType=%3")
-    .arg(infos.raceid)
-    .arg(infos.sexid)
-    .arg(SkinType + sectionOffset);
+  QString query = "SELECT ColorIndex FROM CharSections WHERE RaceID=? AND SexID=? AND SectionType=?";
 
-  sqlResult vals = GAMEDATABASE.sqlQuery(query);
+  sqlResult vals = GAMEDATABASE.sqlQuery(query, QVariantList() << infos.raceid << infos.sexid << (SkinType + sectionOffset));
 
   if (vals.valid && !vals.values.empty())
   {
@@ -383,14 +381,10 @@ void CharDetails::fillCustomizationMap()
   // face possible customization depends on current skin color. We fill m_multiCustomizationMap first
   for (auto it = skin.possibleValues.begin(), itEnd = skin.possibleValues.end(); it != itEnd; ++it)
   {
-    query = QString("SELECT DISTINCT VariationIndex FROM CharSections WHERE RaceID=%1 "
-                    "AND SexID=%2 AND ColorIndex=%3 AND SectionType=%4")
-                    .arg(infos.raceid)
-                    .arg(infos.sexid)
-                    .arg(*it)
-                    .arg(FaceType + sectionOffset);
+    query = "SELECT DISTINCT VariationIndex FROM CharSections WHERE RaceID=? "
+            "AND SexID=? AND ColorIndex=? AND SectionType=?";
 
-    sqlResult faces = GAMEDATABASE.sqlQuery(query);
+    sqlResult faces = GAMEDATABASE.sqlQuery(query, QVariantList() << infos.raceid << infos.sexid << *it << (FaceType + sectionOffset));
 
     CustomizationParam face;
     face.name = "Face";
@@ -412,11 +406,11 @@ void CharDetails::fillCustomizationMap()
 
   // starting from here, customization may differ based on database values
   // get customization names
-  query = QString("SELECT HairCustomization, FacialHairCustomization%1 FROM ChrRaces WHERE ID = %2")
-    .arg(infos.sexid + 1)
-    .arg(infos.raceid);
+  // column depends on sex, only race id is a parameter
+  query = QString("SELECT HairCustomization, FacialHairCustomization%1 FROM ChrRaces WHERE ID = ?")
+    .arg(infos.sexid + 1);
 
-  sqlResult names = GAMEDATABASE.sqlQuery(query);
+  sqlResult names = GAMEDATABASE.sqlQuery(query, QVariantList() << infos.raceid);
 
   QString facialCustomizationBaseName;
   QString additionalCustomizationName;
@@ -439,12 +433,9 @@ void CharDetails::fillCustomizationMap()
   }
 
   // facial style customization
-  query = QString("SELECT DISTINCT VariationIndex FROM CharSections WHERE RaceID = %1 AND SexID = %2 AND SectionType = %3")
-    .arg(infos.raceid)
-    .arg(infos.sexid)
-    .arg(HairType + sectionOffset);
+  query = "SELECT DISTINCT VariationIndex FROM CharSections WHERE RaceID = ? AND SexID = ? AND SectionType = ?";
 
-  sqlResult styles = GAMEDATABASE.sqlQuery(query);
+  sqlResult styles = GAMEDATABASE.sqlQuery(query, QVariantList() << infos.raceid << infos.sexid << (HairType + sectionOffset));
 
   CustomizationParam facialCustomizationStyle;
   facialCustomizationStyle.name = QString(facialCustomizationBaseName + " Style").toStdString();
@@ -465,14 +456,10 @@ void CharDetails::fillCustomizationMap()
   // facial color customization depends on current facial style. We fill m_multiCustomizationMap first
   for (auto it = facialCustomizationStyle.possibleValues.begin(), itEnd = facialCustomizationStyle.possibleValues.end(); it != itEnd; ++it)
   {
-    query = QString("SELECT DISTINCT ColorIndex FROM CharSections WHERE RaceID = %1 AND SexID = %2 "
-                    "AND SectionType = %3 AND VariationIndex = %4")
-                    .arg(infos.raceid)
-                    .arg(infos.sexid)
-                    .arg(HairType + sectionOffset)
-                    .arg(*it);
+    query = "SELECT DISTINCT ColorIndex FROM CharSections WHERE RaceID = ? AND SexID = ? "
+            "AND SectionType = ? AND VariationIndex = ?";
 
-    sqlResult colors = GAMEDATABASE.sqlQuery(query);
+    sqlResult colors = GAMEDATABASE.sqlQuery(query, QVariantList() << infos.raceid << infos.sexid << (HairType + sectionOffset) << *it);
 
     CustomizationParam facialColor;
     facialColor.name = QString(facialCustomizationBaseName + " Color").toStdString();
@@ -493,11 +480,9 @@ void CharDetails::fillCustomizationMap()
   m_customizationParamsMap.insert({ FACIAL_CUSTOMIZATION_COLOR, m_multiCustomizationMap[FACIAL_CUSTOMIZATION_COLOR][m_currentCustomization[FACIAL_CUSTOMIZATION_STYLE]] });
 
   // addtional facial customization
-  query = QString("SELECT DISTINCT VariationID FROM CharacterFacialHairStyles WHERE RaceID = %1 AND SexID = %2")
-    .arg(infos.raceid)
-    .arg(infos.sexid);
+  query = "SELECT DISTINCT VariationID FROM CharacterFacialHairStyles WHERE RaceID = ? AND SexID = ?";
 
-  sqlResult additional = GAMEDATABASE.sqlQuery(query);
+  sqlResult additional = GAMEDATABASE.sqlQuery(query, QVariantList() << infos.raceid << infos.sexid);
 
   CustomizationParam additionalCustomization;
   additionalCustomization.name = additionalCustomizationName.toStdString();
@@ -519,12 +504,9 @@ void CharDetails::fillCustomizationMap()
   CustomizationParam tatoos;
   tatoos.name = "Tatoo";
 
-  query = QString("SELECT ColorIndex FROM CharSections WHERE RaceID=%1 AND SexID=%2 AND SectionType=%3")
-    .arg(infos.raceid)
-    .arg(infos.sexid)
-    .arg(TatooType);
+  query = "SELECT ColorIndex FROM CharSections WHERE RaceID=? AND SexID=? AND SectionType=?";
 
-  vals = GAMEDATABASE.sqlQuery(query);
+  vals = GAMEDATABASE.sqlQuery(query, QVariantList() << infos.raceid << infos.sexid << (int)TatooType);
 
   if (vals.valid && (vals.values.size() > 1))
   {
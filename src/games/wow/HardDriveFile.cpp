@@ -13,7 +13,7 @@
 
 
 HardDriveFile::HardDriveFile(QString path, QString real, int id)
-  : CASCFile(path, id), opened(false), realpath(real), file(0)
+  : CASCFile(path, id), opened(false), realpath(real), file(0), mappedData(0)
 {
 }
 
@@ -29,9 +29,25 @@ bool HardDriveFile::openFile()
   if (!file->open(QIODevice::ReadOnly))
   {
     LOG_ERROR << "Opening" << filepath << "failed.";
+    delete file;
+    file = 0;
     return false;
   }
 
+  // map file in memory so that GameFile reads directly from it instead of copying
+  // whole content into a heap buffer. Private mapping (copy on write) keeps the file
+  // on disk untouched if a reader ever patches buffer content in place
+  unsigned int fileSize = file->size();
+  if (fileSize > 0)
+    mappedData = file->map(0, fileSize, QFileDevice::MapPrivateOption);
+
+  if (mappedData)
+    setExternalBuffer(mappedData, fileSize);
+#ifdef DEBUG_READ
+  else
+    LOG_INFO << "Mapping" << filepath << "failed, fallback to regular read";
+#endif
+
   opened = true;
   return true;
 }
@@ -46,7 +62,7 @@ bool HardDriveFile::isAlreadyOpened()
 
 bool HardDriveFile::getFileSize(unsigned int & s)
 {
-  if (!file && !file->isOpen())
+  if (!file || !file->isOpen())
     return false;
 
   s = file->size();
@@ -55,9 +71,14 @@ bool HardDriveFile::getFileSize(unsigned int & s)
 
 unsigned long HardDriveFile::readFile()
 {
-  if (!file && !file->isOpen())
+  if (!file || !file->isOpen())
     return 0;
 
+  // content already available through mapping, nothing to read.
+  // file must stay opened as long as mapping is in use
+  if (mappedData)
+    return size;
+
   unsigned long s = file->read((char *)buffer, size);
   file->close();
   delete file;
@@ -65,6 +86,43 @@ unsigned long HardDriveFile::readFile()
   return s;
 }
 
+bool HardDriveFile::readContent(core::GameFileBuffer & content, unsigned int & contentSize)
+{
+  // use a dedicated QFile, "file" member belongs to open() / close() cycle
+  QFile * f = new QFile(realpath);
+
+  if (!f->open(QIODevice::ReadOnly))
+  {
+    LOG_ERROR << "Opening" << filepath << "failed.";
+    delete f;
+    return false;
+  }
+
+  contentSize = f->size();
+
+  unsigned char * mapped = (contentSize > 0) ? f->map(0, contentSize, QFileDevice::MapPrivateOption) : 0;
+
+  if (mapped)
+  {
+    // file must stay opened as long as mapping is in use, release both with last reference
+    content.reset(mapped, [f](unsigned char * data)
+    {
+      f->unmap(data);
+      f->close();
+      delete f;
+    });
+    return true;
+  }
+
+  content.reset(new unsigned char[contentSize], std::default_delete<unsigned char[]>());
+  bool result = (f->read((char *)content.get(), contentSize) == contentSize);
+
+  f->close();
+  delete f;
+
+  return result;
+}
+
 bool HardDriveFile::doPostCloseOperation()
 {
 #ifdef DEBUG_READ
@@ -73,5 +131,16 @@ bool HardDriveFile::doPostCloseOperation()
   if(opened)
     opened = false;
 
+  if (file)
+  {
+    if (mappedData)
+      file->unmap(mappedData);
+    file->close();
+    delete file;
+    file = 0;
+  }
+
+  mappedData = 0;
+
   return true;
 }
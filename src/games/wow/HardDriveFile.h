@@ -34,12 +34,13 @@ class _HARDDRIVEFILE_API_ HardDriveFile : public CASCFile
     virtual bool getFileSize(unsigned int & s);
     virtual unsigned long readFile();
     virtual bool doPostCloseOperation();
-
+    virtual bool readContent(core::GameFileBuffer & content, unsigned int & contentSize);
 
   private:
     bool opened;
     QString realpath;
     QFile * file;
+    unsigned char * mappedData; // file content mapped in memory, if mapping succeeded
 };
 
 
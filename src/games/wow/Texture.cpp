@@ -10,6 +10,9 @@
 
 #include "OpenGLHeaders.h"
 
+// magic + type + attributes + width + height + 16 mipmap offsets + 16 mipmap sizes
+#define BLP_HEADER_SIZE 148
+
 Texture::Texture(GameFile * f)
 : ManagedItem(f->fullname()), w(0), h(0), id(0), compressed(false), file(f)
 {
@@ -32,8 +35,11 @@ void Texture::load()
   // bind the texture
   glBindTexture(GL_TEXTURE_2D, id);
 
-  if (!file || !file->open() || file->isEof()) 
+  // read header first, to know which part of file is really needed
+  if (!file || !file->openHeader(BLP_HEADER_SIZE) || file->getSize() < BLP_HEADER_SIZE)
   {
+    if (file)
+      file->close();
     id = 0;
     return;
   }
@@ -52,6 +58,24 @@ void Texture::load()
   bool hasmipmaps = (attr[3]>0);
   size_t mipmax = hasmipmaps ? 16 : 1;
 
+  // without mipmaps, only first level is uploaded : it directly follows header (and palette),
+  // so there is no need to decode the rest of the file. Otherwise read whole file, through the
+  // handle already opened for header
+  bool opened = false;
+  if (hasmipmaps || offsets[0] <= 0 || sizes[0] <= 0)
+    opened = file->open();
+  else
+    opened = file->openRange(0, offsets[0] + sizes[0]);
+
+  if (!opened || file->isEof())
+  {
+    file->close();
+    id = 0;
+    return;
+  }
+
+  file->seek(BLP_HEADER_SIZE);
+
   w = width;
   h = height;
 
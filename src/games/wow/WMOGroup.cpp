@@ -92,28 +92,22 @@ void WMOGroup::initDisplayList()
   b1 = Vec3D(gh.box1[0], gh.box1[2], -gh.box1[1]);
   b2 = Vec3D(gh.box2[0], gh.box2[2], -gh.box2[1]);
 
-  gf.seek(0x58); // first chunk
+  core::ChunkDirectory directory;
+  directory.build(gf.getBuffer(), 0x58, gf.getSize(), true); // first chunk at 0x58
 
   uint32 size;
 
   cv = 0;
   hascv = false;
 
-  while (!gf.isEof()) {
-    char buf[5];
-    gf.read(buf, 4);
-    buf[4] = 0;
-
-    QString fourcc = QString::fromLatin1(buf);
-    WMO::flipcc(fourcc);
-
-    gf.read(&size, 4);
-
-    size_t nextpos = gf.getPos() + size;
+  for (auto & chunk : directory) {
+    unsigned int fourcc = chunk.magic;
+    size = chunk.size;
+    gf.seek(chunk.start);
 
     // why copy stuff when I can just map it from memory ^_^
 
-    if (fourcc == "MOPY") {
+    if (fourcc == core::fourcc("MOPY")) {
 
       //			Material info for triangles, two bytes per triangle. So size of this chunk in bytes is twice the number of triangles in the WMO group.
       //			Offset	Type	Description
@@ -153,13 +147,13 @@ void WMOGroup::initDisplayList()
       materials = new uint16[nTriangles];
       gf.read(materials, size);
     }
-    else if (fourcc == "MOVI") {
+    else if (fourcc == core::fourcc("MOVI")) {
       //			Vertex indices for triangles. Three 16-bit integers per triangle, that are indices into the vertex list. The numbers specify the 3 vertices for each triangle, their order makes it possible to do backface culling.
       nIndices = (size / 2);
       indices = new uint16[nIndices];
       gf.read(indices, nIndices * 2);
     }
-    else if (fourcc == "MOVT") {
+    else if (fourcc == core::fourcc("MOVT")) {
       //			Vertices chunk. 3 floats per vertex, the coordinates are in (X,Z,-Y) order. It's likely that WMOs and models (M2s) were created in a coordinate system with the Z axis pointing up and the Y axis into the screen, whereas in OpenGL, the coordinate system used in WoWmapview the Z axis points toward the viewer and the Y axis points up. Hence the juggling around with coordinates.
       nVertices = (size / 12);
       // let's hope it's padded to 12 bytes, not 16...
@@ -180,26 +174,26 @@ void WMOGroup::initDisplayList()
       center = (vmax + vmin) * 0.5f;
       rad = (vmax - center).length();
     }
-    else if (fourcc == "MONR") {
+    else if (fourcc == core::fourcc("MONR")) {
       // Normals. 3 floats per vertex normal, in (X,Z,-Y) order.
       uint32 tSize = (uint32)(size / 12);
       normals = new Vec3D[tSize];
       gf.read(normals, size);
     }
-    else if (fourcc == "MOTV") {
+    else if (fourcc == core::fourcc("MOTV")) {
       // Texture coordinates, 2 floats per vertex in (X,Y) order. The values range from 0.0 to 1.0. Vertices, normals and texture coordinates are in corresponding order, of course.
       uint32 tSize = (uint32)(size / 8);
       texcoords = new Vec2D[tSize];
       gf.read(texcoords, size);
     }
-    else if (fourcc == "MOLR") {
+    else if (fourcc == core::fourcc("MOLR")) {
       //			Light references, one 16-bit integer per light reference.
       //			This is basically a list of lights used in this WMO group, the numbers are indices into the WMO root file's MOLT table.
       //			For some WMO groups there is a large number of lights specified here, more than what a typical video card will handle at once. I wonder how they do lighting properly. Currently, I just turn on the first GL_MAX_LIGHTS and hope for the best. :(
       nLR = (int)size / 2;
       useLights = (short*)gf.getPointer();
     }
-    else if (fourcc == "MODR") {
+    else if (fourcc == core::fourcc("MODR")) {
       //			Doodad references, one 16-bit integer per doodad.
       //			The numbers are indices into the doodad instance table (MODD chunk) of the WMO root file. These have to be filtered to the doodad set being used in any given WMO instance.
       /*
@@ -208,7 +202,7 @@ void WMOGroup::initDisplayList()
       gf.read(ddr,size);
       */
     }
-    else if (fourcc == "MOBN") {
+    else if (fourcc == core::fourcc("MOBN")) {
       //			Array of t_BSP_NODE.
       //			struct t_BSP_NODE
       //			{
@@ -223,10 +217,10 @@ void WMOGroup::initDisplayList()
       //													2005-4-4 by linghuye
       //			This+BoundingBox(in wmo_root.MOGI) is used for Collision --Tigurius
     }
-    else if (fourcc == "MOBR") {
+    else if (fourcc == core::fourcc("MOBR")) {
       // Triangle indices (in MOVI which define triangles) to describe polygon planes defined by MOBN BSP nodes.
     }
-    else if (fourcc == "MOBA") {
+    else if (fourcc == core::fourcc("MOBA")) {
       //			Render batches. Records of 24 bytes.
       //			struct SMOBatch // 03-29-2005 By ObscuR
       //			{
@@ -287,7 +281,7 @@ void WMOGroup::initDisplayList()
       //			int l = nBatches-1;
       //			gLog("Max index: %d\n", ba[l].indexStart + ba[l].indexCount);
     }
-    else if (fourcc == "MOCV") {
+    else if (fourcc == core::fourcc("MOCV")) {
       size_t spos = gf.getPos();
       //			Vertex colors, 4 bytes per vertex (BGRA), for WMO groups using indoor lighting.
       //			I don't know if this is supposed to work together with, or replace, the lights referenced in MOLR. But it sure is the only way for the ground around the goblin smelting pot to turn red in the Deadmines. (but some corridors are, in turn, too dark - how the hell does lighting work anyway, are there lightmaps hidden somewhere?)
@@ -308,15 +302,13 @@ void WMOGroup::initDisplayList()
       //				VertexColors.push_back(vc);
       //			}
     }
-    else if (fourcc == "MLIQ") {
+    else if (fourcc == core::fourcc("MLIQ")) {
       // liquids
       WMOLiquidHeader hlq;
       gf.read(&hlq, sizeof(WMOLiquidHeader));
     }
 
     // TODO: figure out/use MFOG ?
-
-    gf.seek(nextpos);
   }
 
   // ok, make a display list
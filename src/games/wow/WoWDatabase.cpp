@@ -15,6 +15,7 @@
 #include "wdb2file.h"
 #include "wdb5file.h"
 #include "wdb6file.h"
+#include "wdc1file.h"
 
 const std::vector<QString> POSSIBLE_DB_EXT = {".db2", ".dbc"};
 
@@ -59,6 +60,7 @@ void wow::WoWDatabase::readSpecificFieldAttributes(QDomElement & e, core::FieldS
 
   QDomNode pos = attributes.namedItem("pos");
   QDomNode commonData = attributes.namedItem("commonData");
+  QDomNode relationshipData = attributes.namedItem("relationshipData");
 
   if (!pos.isNull())
     field->pos = pos.nodeValue().toInt();
@@ -66,6 +68,9 @@ void wow::WoWDatabase::readSpecificFieldAttributes(QDomElement & e, core::FieldS
   if (!commonData.isNull())
     field->isCommonData = true;
 
+  if (!relationshipData.isNull())
+    field->isRelationshipData = true;
+
 }
 
 DBFile * wow::TableStructure::createDBFile()
@@ -90,10 +95,12 @@ DBFile * wow::TableStructure::createDBFile()
   
   if (fileToOpen)
   {
-    if (fileToOpen->open())
+    // only header is needed to choose file format, don't decode whole file
+    if (fileToOpen->openHeader(sizeof(WDB5File::header)))
     {
       char header[5];
 
+      fileToOpen->seek(0);
       fileToOpen->read(header, 4);
 
       if (strncmp(header, "WDB2", 4) == 0)
@@ -102,6 +109,17 @@ DBFile * wow::TableStructure::createDBFile()
         result = new WDB5File(fileToOpen->fullname());
       else if (strncmp(header, "WDB6", 4) == 0)
         result = new WDB6File(fileToOpen->fullname());
+      else if (strncmp(header, "WDC1", 4) == 0)
+        result = new WDC1File(fileToOpen->fullname());
+
+      // check that structure described in xml matches file one
+      if (hash != 0 && (strncmp(header, "WDB5", 4) == 0 || strncmp(header, "WDB6", 4) == 0 || strncmp(header, "WDC1", 4) == 0))
+      {
+        WDB5File::header wdb5header;
+        fileToOpen->seek(0);
+        if (fileToOpen->read(&wdb5header, sizeof(wdb5header)) == sizeof(wdb5header) && wdb5header.layout_hash != hash)
+          LOG_WARNING << "Layout hash mismatch for" << file << ": expected" << hash << "found" << wdb5header.layout_hash;
+      }
 
       fileToOpen->close();
     }
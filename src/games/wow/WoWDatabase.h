@@ -50,12 +50,13 @@ namespace wow
   {
   public:
     FieldStructure() :
-      core::FieldStructure(), pos(-1), isCommonData(false)
+      core::FieldStructure(), pos(-1), isCommonData(false), isRelationshipData(false)
     {
     }
 
     int pos;
     bool isCommonData;
+    bool isRelationshipData; // foreign key stored in relationship block of WDC1 files
 
   };
 
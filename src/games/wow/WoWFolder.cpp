@@ -7,13 +7,21 @@
 
 #include "WoWFolder.h"
 
+#include <cstring> // memchr
+
+#include <QDateTime>
 #include <QDirIterator>
+#include <QElapsedTimer>
 #include <QFile>
+#include <QFileInfo>
+#include <QReadLocker>
 #include <QRegularExpression>
+#include <QWriteLocker>
 
 #include "CASCFile.h"
 #include "Game.h"
 #include "HardDriveFile.h"
+#include "ListfileIndex.h"
 
 #include "logger/Logger.h"
 
@@ -28,31 +36,127 @@ void wow::WoWFolder::init()
 }
 
 
-void wow::WoWFolder::initFromListfile(const QString & filename)
+void wow::WoWFolder::initFromListfile(const QString & filename, ProgressCallback progress)
 {
-  QFile file(core::Game::instance().configFolder() + filename);
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+  QString listfile = core::Game::instance().configFolder() + filename;
+  QFileInfo listfileInfo(listfile);
+  QString indexfile = core::Game::instance().configFolder() + listfileInfo.completeBaseName() + ".idx";
+
+  // resolved listfile is only valid for a given game build and listfile content
+  QByteArray key = QString("%1|%2|%3").arg(version())
+                                      .arg(listfileInfo.size())
+                                      .arg(listfileInfo.lastModified().toMSecsSinceEpoch()).toUtf8();
+
+  // binary listfile generated by ListFileGenerator --binary is keyed with the game build it was
+  // resolved against, it is used unless game was updated or text listfile was updated after it
+  QFileInfo prebuiltInfo(core::Game::instance().configFolder() + listfileInfo.completeBaseName() + ".bin");
+  bool usePrebuilt = prebuiltInfo.exists() &&
+                     (!listfileInfo.exists() || prebuiltInfo.lastModified() >= listfileInfo.lastModified());
+
+  core::ListfileIndex index;
+  if ((usePrebuilt && index.load(prebuiltInfo.filePath(), version().toUtf8())) || index.load(indexfile, key))
+  {
+    LOG_INFO << "WoWFolder - Start to build file table from" << index.fileName();
+    core::FileTable table;
+    for (unsigned int i = 0; i < index.size(); i++)
+      table.add(index.name(i), index.id(i));
+    table.buildIndexes();
+    setFileTable(std::move(table));
+    LOG_INFO << "WoWFolder - File table creation done";
+
+    if (progress)
+      progress(index.size(), index.size());
+    return;
+  }
+
+  QFile file(listfile);
+  if (!file.open(QIODevice::ReadOnly))
   {
     LOG_ERROR << "Fail to open" << filename;
     return;
   }
 
-  QTextStream in(&file);
+  LOG_INFO << "WoWFolder - Start to build file table";
+
+  QElapsedTimer timer;
+  timer.start();
+
+  // normalize names in one pass over raw bytes (lower case, '/' separators), counting lines meanwhile
+  QByteArray content = file.readAll();
+  file.close();
+
+  unsigned int nbLines = 0;
+  for (char * c = content.data(), * end = c + content.size(); c < end; ++c)
+  {
+    if (*c >= 'A' && *c <= 'Z')
+      *c += 'a' - 'A';
+    else if (*c == '\\')
+      *c = '/';
+    else if (*c == '\n')
+      nbLines++;
+  }
+
+  // resolve names in listfile order. Lookups go through CASC storage lock, so they are done
+  // in a single pass on calling thread : splitting them over worker threads doesn't make them faster
+  static const unsigned int PROGRESS_STEP = 4096;
+
+  std::vector<core::ListfileIndex::Entry> entries;
+  std::string name;
+  unsigned int linesDone = 0;
 
-  LOG_INFO << "WoWFolder - Start to build object hierarchy";
-  while (!in.atEnd())
+  const char * end = content.constData() + content.size();
+  for (const char * line = content.constData(); line < end;)
   {
-    QString line = in.readLine().toLower();
+    const char * lineEnd = (const char *)memchr(line, '\n', end - line);
+    if (!lineEnd)
+      lineEnd = end;
 
-    int id = m_CASCFolder.fileDataId(line.toStdString());
-    if (id != 0)
+    const char * nameEnd = lineEnd;
+    while (nameEnd > line && (nameEnd[-1] == '\r' || nameEnd[-1] == ' '))
+      nameEnd--;
+
+    if (nameEnd > line)
     {
-      CASCFile * file = new CASCFile(line, id);
-      file->setName(line.mid(line.lastIndexOf('/') + 1));
-      addChild(file);
+      name.assign(line, nameEnd);
+      int id = m_CASCFolder.fileDataId(name);
+      if (id != 0)
+      {
+        core::ListfileIndex::Entry entry;
+        entry.name = QByteArray(name.data(), (int)name.size());
+        entry.id = id;
+        entries.push_back(entry);
+      }
     }
+
+    line = lineEnd + 1;
+
+    if (progress && (++linesDone % PROGRESS_STEP) == 0)
+      progress(linesDone, nbLines);
   }
-  LOG_INFO << "WoWFolder - Hierarchy creation done";
+
+  core::FileTable table;
+  table.reserve((unsigned int)entries.size(), (unsigned int)content.size());
+  for (auto & it : entries)
+    table.add(it.name, it.id);
+  table.buildIndexes();
+  setFileTable(std::move(table));
+
+  if (progress)
+    progress(nbLines, nbLines);
+
+  qint64 elapsed = timer.nsecsElapsed();
+  LOG_INFO << "WoWFolder - File table creation done:" << entries.size() << "files resolved from" << nbLines << "lines in"
+           << elapsed / 1000000 << "ms";
+
+  if (core::ListfileIndex::save(indexfile, key, entries))
+    LOG_INFO << "WoWFolder - Listfile index saved to" << indexfile;
+}
+
+GameFile * wow::WoWFolder::createFile(const QString & path, int id)
+{
+  CASCFile * file = new CASCFile(path, id);
+  file->setName(path.mid(path.lastIndexOf('/') + 1));
+  return file;
 }
 
 void wow::WoWFolder::addCustomFiles(const QString & path, bool bypassOriginalFiles)
@@ -109,11 +213,29 @@ GameFile * wow::WoWFolder::getFile(int id)
   if (id <= 0) // bad id given
     return result;
 
+  unsigned int entry = core::FileTable::npos;
+
+  {
+    QReadLocker locker(&m_filesLock);
+    auto it = m_idMap.find(id);
+    if (it != m_idMap.end())
+      return it->second;
+
+    entry = m_fileTable.findById(id);
+  }
+
+  if (entry != core::FileTable::npos)
+    return getTableFile(entry);
+
+  // not in listfile, try to force open by id. Keep lock until file is added, so that
+  // two threads asking for same id don't create it twice
+  QWriteLocker locker(&m_filesLock);
+
   auto it = m_idMap.find(id);
   if (it != m_idMap.end())
     result = it->second;
 
-  if (!result) // if not found, try to force open by id
+  if (!result)
   {
     // Build File########.unk filename needed for CASC lib to open file based on id
     QString filename = QString("File%1.unk").arg(id, 8, 16, QLatin1Char('0'));
@@ -140,6 +262,30 @@ bool wow::WoWFolder::openFile(std::string file, HANDLE * result)
   return m_CASCFolder.openFile(file, result);
 }
 
+bool wow::WoWFolder::readFile(HANDLE file, unsigned char * buffer, unsigned int size, unsigned long * read)
+{
+  return m_CASCFolder.readFile(file, buffer, size, read);
+}
+
+bool wow::WoWFolder::readFileRange(HANDLE file, unsigned int offset, unsigned char * buffer, unsigned int size, unsigned long * read)
+{
+  return m_CASCFolder.readFileRange(file, offset, buffer, size, read);
+}
+
+bool wow::WoWFolder::closeFile(HANDLE file)
+{
+  return m_CASCFolder.closeFile(file);
+}
+
+bool wow::WoWFolder::decodeFile(GameFile * file, core::GameFileBuffer & buffer, unsigned int & size)
+{
+  // custom files are read from hard drive, no decoding needed
+  if (dynamic_cast<HardDriveFile *>(file))
+    return false;
+
+  return m_CASCFolder.decodeFile(file->fullname().toStdString(), buffer, size);
+}
+
 QString wow::WoWFolder::version()
 {
   return m_CASCFolder.version();
@@ -167,12 +313,14 @@ int wow::WoWFolder::lastError()
 
 void wow::WoWFolder::onChildAdded(GameFile * child)
 {
+  QWriteLocker locker(&m_filesLock);
   GameFolder::onChildAdded(child);
   m_idMap[child->fileDataId()] = child;
 }
 
 void wow::WoWFolder::onChildRemoved(GameFile * child)
 {
+  QWriteLocker locker(&m_filesLock);
   GameFolder::onChildRemoved(child);
   m_idMap.erase(child->fileDataId());
 }
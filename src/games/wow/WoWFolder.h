@@ -39,7 +39,7 @@ namespace wow
       virtual ~WoWFolder() {}
 
       void init();
-      void initFromListfile(const QString & file);
+      void initFromListfile(const QString & file, ProgressCallback progress = ProgressCallback());
       void addCustomFiles(const QString & path, bool bypassOriginalFiles);
 
       GameFile * getFile(int id);
@@ -56,7 +56,17 @@ namespace wow
       void onChildAdded(GameFile *);
       void onChildRemoved(GameFile *);
 
+      bool readFile(HANDLE file, unsigned char * buffer, unsigned int size, unsigned long * read);
+      bool readFileRange(HANDLE file, unsigned int offset, unsigned char * buffer, unsigned int size, unsigned long * read);
+      bool closeFile(HANDLE file);
+
+      bool decodeFile(GameFile * file, core::GameFileBuffer & buffer, unsigned int & size);
+
+    protected:
+      GameFile * createFile(const QString & path, int id);
+
     private:
+
       CASCFolder m_CASCFolder;
       std::map<int, GameFile *> m_idMap;
   };
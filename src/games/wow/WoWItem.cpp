@@ -33,6 +33,7 @@
 
 
 #include "Attachment.h"
+#include "ColumnTable.h"
 #include "database.h" // items
 #include "Game.h"
 #include "globalvars.h"
@@ -51,6 +52,56 @@ map<CharSlots, int> WoWItem::SLOT_LAYERS = { { CS_SHIRT, 10 }, { CS_HEAD, 11 },
                                              { CS_GLOVES, 20 }, { CS_HAND_RIGHT, 21 }, { CS_HAND_LEFT, 22 },
                                              { CS_CAPE, 23 }, { CS_QUIVER, 24 } };
 
+namespace
+{
+  // display id of an item appearance, -1 if not found
+  int displayIdForAppearance(int appearanceId)
+  {
+    const core::ColumnTable * appearances = GAMEDATABASE.columnTable("ItemAppearance");
+    if (appearances)
+    {
+      unsigned int row = appearances->find(appearanceId);
+      if (row == core::ColumnTable::npos)
+        return -1;
+
+      return (int)appearances->integer(row, appearances->column("ItemDisplayInfoID"));
+    }
+
+    sqlResult r = GAMEDATABASE.sqlQuery("SELECT ItemDisplayInfoID FROM ItemAppearance WHERE ID = ?", QVariantList() << appearanceId);
+
+    if (!r.valid || r.values.empty())
+      return -1;
+
+    return r.values[0][0].toInt();
+  }
+
+  // file ids listed in ModelFileData / TextureFileData for a model / texture id used by ItemDisplayInfo
+  std::vector<int> fileDataIds(const QString & table, const QString & fileColumn, int id)
+  {
+    std::vector<int> result;
+
+    const core::ColumnTable * files = GAMEDATABASE.columnTable(table);
+    if (files)
+    {
+      int fileColumnIndex = files->column(fileColumn);
+      for (auto row : files->findAll(files->column("ID"), id))
+        result.push_back((int)files->integer(row, fileColumnIndex));
+
+      return result;
+    }
+
+    sqlResult r = GAMEDATABASE.sqlQuery(QString("SELECT %1 FROM %2 WHERE ID = ?").arg(fileColumn).arg(table), QVariantList() << id);
+
+    if (r.valid)
+    {
+      for (auto & row : r.values)
+        result.push_back(row[0].toInt());
+    }
+
+    return result;
+  }
+}
+
 
 WoWItem::WoWItem(CharSlots slot)
   : m_charModel(0), m_id(-1), m_quality(0),
@@ -83,8 +134,8 @@ void WoWItem::setId(int id)
       return;
     }
 
-    QString query = QString("SELECT ItemLevel, ItemAppearanceID FROM ItemModifiedAppearance WHERE ItemID = %1").arg(id);
-    sqlResult itemlevels = GAMEDATABASE.sqlQuery(query);
+    QString query = "SELECT ItemLevel, ItemAppearanceID FROM ItemModifiedAppearance WHERE ItemID = ?";
+    sqlResult itemlevels = GAMEDATABASE.sqlQuery(query, QVariantList() << id);
 
     if (itemlevels.valid && !itemlevels.values.empty())
     {
@@ -118,13 +169,10 @@ void WoWItem::setId(int id)
       }
     }
 
-    query = QString("SELECT ItemDisplayInfoID FROM ItemAppearance WHERE ID = %1")
-      .arg(m_levelDisplayMap[m_level]);
-
-    sqlResult iteminfos = GAMEDATABASE.sqlQuery(query);
+    int displayId = displayIdForAppearance(m_levelDisplayMap[m_level]);
 
-    if (iteminfos.valid && !iteminfos.values.empty())
-      m_displayId = iteminfos.values[0][0].toInt();
+    if (displayId != -1)
+      m_displayId = displayId;
 
     ItemRecord itemRcd = items.getById(id);
     setName(itemRcd.name);
@@ -151,13 +199,10 @@ void WoWItem::setLevel(unsigned int level)
   {
     m_level = level;
 
-    QString query = QString("SELECT ItemDisplayInfoID FROM ItemAppearance WHERE ID = %1")
-      .arg(m_levelDisplayMap[m_level]);
+    int displayId = displayIdForAppearance(m_levelDisplayMap[m_level]);
 
-    sqlResult iteminfos = GAMEDATABASE.sqlQuery(query);
-
-    if (iteminfos.valid && !iteminfos.values.empty())
-      m_displayId = iteminfos.values[0][0].toInt();
+    if (displayId != -1)
+      m_displayId = displayId;
 
     ItemRecord itemRcd = items.getById(m_id);
     setName(itemRcd.name);
@@ -228,12 +273,12 @@ void WoWItem::load()
   {
     case CS_HEAD:
     {
-      QString query = QString("SELECT ModelID, TextureID FROM ItemDisplayInfo "
-                              "LEFT JOIN ModelFileData ON Model1 = ModelFileData.ID "
-                              "LEFT JOIN TextureFileData ON TextureItemID1 = TextureFileData.ID "
-                              "WHERE ItemDisplayInfo.ID = %1").arg(m_displayId);
+      QString query = "SELECT ModelID, TextureID FROM ItemDisplayInfo "
+                      "LEFT JOIN ModelFileData ON Model1 = ModelFileData.ID "
+                      "LEFT JOIN TextureFileData ON TextureItemID1 = TextureFileData.ID "
+                      "WHERE ItemDisplayInfo.ID = ?";
 
-      sqlResult iteminfos = filterSQLResultForModel(GAMEDATABASE.sqlQuery(query), MODEL, 0);
+      sqlResult iteminfos = filterSQLResultForModel(GAMEDATABASE.sqlQuery(query, QVariantList() << m_displayId), MODEL, 0);
 
       if (!iteminfos.valid || iteminfos.values.empty())
       {
@@ -247,11 +292,11 @@ void WoWItem::load()
     }
     case CS_SHOULDER:
     {
-      QString query = QString("SELECT Model1, TextureItemID1, Model2, TextureItemID2 FROM ItemDisplayInfo "
-                              "WHERE ItemDisplayInfo.ID = %1").arg(m_displayId);
+      QString query = "SELECT Model1, TextureItemID1, Model2, TextureItemID2 FROM ItemDisplayInfo "
+                      "WHERE ItemDisplayInfo.ID = ?";
 
 
-      sqlResult iteminfos = GAMEDATABASE.sqlQuery(query);
+      sqlResult iteminfos = GAMEDATABASE.sqlQuery(query, QVariantList() << m_displayId);
 
       if (!iteminfos.valid || iteminfos.values.empty())
       {
@@ -261,37 +306,34 @@ void WoWItem::load()
 
       if ((iteminfos.values[0][0].toInt() != 0) && (iteminfos.values[0][2].toInt() != 0)) // both shoulders
       {
-        sqlResult modelinfos = GAMEDATABASE.sqlQuery(QString("SELECT ModelID FROM ModelFileData WHERE ID = %1").arg(iteminfos.values[0][0]));
-        sqlResult texinfos = GAMEDATABASE.sqlQuery(QString("SELECT ID, TextureID FROM TextureFileData WHERE ID IN( %1, %2)").arg(iteminfos.values[0][1]).arg(iteminfos.values[0][3]));
+        std::vector<int> models = fileDataIds("ModelFileData", "ModelID", iteminfos.values[0][0].toInt());
+        // left texture may be different from right one
+        std::vector<int> leftTextures = fileDataIds("TextureFileData", "TextureID", iteminfos.values[0][1].toInt());
+        std::vector<int> rightTextures = fileDataIds("TextureFileData", "TextureID", iteminfos.values[0][3].toInt());
 
-        if (!modelinfos.valid || modelinfos.values.empty() || !texinfos.valid || texinfos.values.empty())
+        if (models.size() < 2 || (leftTextures.empty() && rightTextures.empty()))
         {
           LOG_ERROR << "Impossible to query model & texture information for item" << name() << "(id " << m_id << "- display id" << m_displayId << ")";
           return;
         }
 
         // associate left / right model infos
-        GameFile * file = GAMEDIRECTORY.getFile(modelinfos.values[0][0].toInt());
+        GameFile * file = GAMEDIRECTORY.getFile(models[0]);
         int leftmodelindex = (file->fullname().contains("lshoulder", Qt::CaseInsensitive) || file->fullname().endsWith("_l.m2", Qt::CaseInsensitive)) ? 0 : 1;
         int rightmodelindex = leftmodelindex ? 0 : 1;
 
-        // create texture map to use result correctly (especially when left texture is diffrent from right texture)
-        std::map<QString, int> textures;
-        for (uint i = 0; i < texinfos.values.size(); i++)
-          textures[texinfos.values[i][0]] = texinfos.values[i][1].toInt();
-
         // left shoulder
-        updateItemModel(ATT_LEFT_SHOULDER, modelinfos.values[leftmodelindex][0].toInt(), textures[iteminfos.values[0][1]]);
+        updateItemModel(ATT_LEFT_SHOULDER, models[leftmodelindex], leftTextures.empty() ? 0 : leftTextures.back());
 
         // right shoulder
-        updateItemModel(ATT_RIGHT_SHOULDER, modelinfos.values[rightmodelindex][0].toInt(), textures[iteminfos.values[0][3]]);
+        updateItemModel(ATT_RIGHT_SHOULDER, models[rightmodelindex], rightTextures.empty() ? 0 : rightTextures.back());
       }
       else if (iteminfos.values[0][2].toInt() == 0) // only left shoulder
       {
-        sqlResult modelinfos = GAMEDATABASE.sqlQuery(QString("SELECT ModelID FROM ModelFileData WHERE ID = %1").arg(iteminfos.values[0][0]));
-        sqlResult texinfos = GAMEDATABASE.sqlQuery(QString("SELECT TextureID FROM TextureFileData WHERE ID = %1").arg(iteminfos.values[0][1]));
+        std::vector<int> models = fileDataIds("ModelFileData", "ModelID", iteminfos.values[0][0].toInt());
+        std::vector<int> textures = fileDataIds("TextureFileData", "TextureID", iteminfos.values[0][1].toInt());
 
-        if (!modelinfos.valid || modelinfos.values.empty() || !texinfos.valid || texinfos.values.empty())
+        if (models.empty() || textures.empty())
         {
           LOG_ERROR << "Impossible to query model & texture information for item" << name() << "(id " << m_id << "- display id" << m_displayId << ")";
           return;
@@ -299,9 +341,9 @@ void WoWItem::load()
 
         int leftmodelindex = -1;
 
-        for (uint i = 0; i < modelinfos.values.size(); i++)
+        for (uint i = 0; i < models.size(); i++)
         {
-          GameFile * file = GAMEDIRECTORY.getFile(modelinfos.values[i][0].toInt());
+          GameFile * file = GAMEDIRECTORY.getFile(models[i]);
           if (file)
           {
             if (file->fullname().contains("lshoulder", Qt::CaseInsensitive))
@@ -309,14 +351,15 @@ void WoWItem::load()
           }
         }
 
-        updateItemModel(ATT_LEFT_SHOULDER, modelinfos.values[leftmodelindex][0].toInt(), texinfos.values[0][0].toInt());
+        if (leftmodelindex != -1)
+          updateItemModel(ATT_LEFT_SHOULDER, models[leftmodelindex], textures[0]);
       }
       else if (iteminfos.values[0][0].toInt() == 0) // only right shoulder 
       {
-        sqlResult modelinfos = GAMEDATABASE.sqlQuery(QString("SELECT ModelID FROM ModelFileData WHERE ID = %1").arg(iteminfos.values[0][2]));
-        sqlResult texinfos = GAMEDATABASE.sqlQuery(QString("SELECT TextureID FROM TextureFileData WHERE ID = %1").arg(iteminfos.values[0][3]));
+        std::vector<int> models = fileDataIds("ModelFileData", "ModelID", iteminfos.values[0][2].toInt());
+        std::vector<int> textures = fileDataIds("TextureFileData", "TextureID", iteminfos.values[0][3].toInt());
 
-        if (!modelinfos.valid || modelinfos.values.empty() || !texinfos.valid || texinfos.values.empty())
+        if (models.empty() || textures.empty())
         {
           LOG_ERROR << "Impossible to query model & texture information for item" << name() << "(id " << m_id << "- display id" << m_displayId << ")";
           return;
@@ -324,9 +367,9 @@ void WoWItem::load()
 
         int rightmodelindex = -1;
 
-        for (uint i = 0; i < modelinfos.values.size(); i++)
+        for (uint i = 0; i < models.size(); i++)
         {
-          GameFile * file = GAMEDIRECTORY.getFile(modelinfos.values[i][0].toInt());
+          GameFile * file = GAMEDIRECTORY.getFile(models[i]);
           if (file)
           {
             if (file->fullname().contains("rshoulder", Qt::CaseInsensitive))
@@ -335,18 +378,18 @@ void WoWItem::load()
         }
 
         if (rightmodelindex != -1)
-          updateItemModel(ATT_RIGHT_SHOULDER, modelinfos.values[rightmodelindex][0].toInt(), texinfos.values[0][0].toInt());
+          updateItemModel(ATT_RIGHT_SHOULDER, models[rightmodelindex], textures[0]);
       }
       break;
     }
     case CS_BOOTS:
     {
       // query texture infos from ItemDisplayInfoMaterialRes
-      QString query = QString("SELECT TextureID FROM ItemDisplayInfoMaterialRes "
-                              "LEFT JOIN TextureFileData ON TextureFileDataID = TextureFileData.ID "
-                              "WHERE ItemDisplayInfoID = %1").arg(m_displayId);
+      QString query = "SELECT TextureID FROM ItemDisplayInfoMaterialRes "
+                      "LEFT JOIN TextureFileData ON TextureFileDataID = TextureFileData.ID "
+                      "WHERE ItemDisplayInfoID = ?";
 
-      sqlResult iteminfos = filterSQLResultForModel(GAMEDATABASE.sqlQuery(query), TEXTURE, 0);
+      sqlResult iteminfos = filterSQLResultForModel(GAMEDATABASE.sqlQuery(query, QVariantList() << m_displayId), TEXTURE, 0);
 
       if (!iteminfos.valid || iteminfos.values.empty())
       {
@@ -365,12 +408,12 @@ void WoWItem::load()
       }
 
       // now get geoset / model infos
-      query = QString("SELECT ModelID, TextureID, GeoSetGroup1 FROM ItemDisplayInfo "
-                      "LEFT JOIN ModelFileData ON Model1 = ModelFileData.ID "
-                      "LEFT JOIN TextureFileData ON TextureItemID1 = TextureFileData.ID "
-                      "WHERE ItemDisplayInfo.ID = %1").arg(m_displayId);
+      query = "SELECT ModelID, TextureID, GeoSetGroup1 FROM ItemDisplayInfo "
+              "LEFT JOIN ModelFileData ON Model1 = ModelFileData.ID "
+              "LEFT JOIN TextureFileData ON TextureItemID1 = TextureFileData.ID "
+              "WHERE ItemDisplayInfo.ID = ?";
 
-      iteminfos = GAMEDATABASE.sqlQuery(query);
+      iteminfos = GAMEDATABASE.sqlQuery(query, QVariantList() << m_displayId);
 
       if (!iteminfos.valid || iteminfos.values.empty())
       {
@@ -391,11 +434,11 @@ void WoWItem::load()
     case CS_BELT:
     {
       // query texture infos from ItemDisplayInfoMaterialRes
-      QString query = QString("SELECT TextureID FROM ItemDisplayInfoMaterialRes "
-                              "LEFT JOIN TextureFileData ON TextureFileDataID = TextureFileData.ID "
-                              "WHERE ItemDisplayInfoID = %1").arg(m_displayId);
+      QString query = "SELECT TextureID FROM ItemDisplayInfoMaterialRes "
+                      "LEFT JOIN TextureFileData ON TextureFileDataID = TextureFileData.ID "
+                      "WHERE ItemDisplayInfoID = ?";
 
-      sqlResult iteminfos = filterSQLResultForModel(GAMEDATABASE.sqlQuery(query), TEXTURE, 0);
+      sqlResult iteminfos = filterSQLResultForModel(GAMEDATABASE.sqlQuery(query, QVariantList() << m_displayId), TEXTURE, 0);
 
       if (!iteminfos.valid /* || iteminfos.values.empty() */) // some belts have no texture, only model
       {
@@ -414,14 +457,14 @@ void WoWItem::load()
       }
 
       // now get geoset / model infos
-      query = QString("SELECT MFD1.ModelID, TFD1.TextureID, MFD2.ModelID, TFD2.TextureID FROM ItemDisplayInfo "
-                      "LEFT JOIN ModelFileData AS MFD1 ON Model1 = MFD1.ID "
-                      "LEFT JOIN TextureFileData AS TFD1 ON TextureItemID1 = TFD1.ID "
-                      "LEFT JOIN ModelFileData AS MFD2 ON Model2 = MFD2.ID "
-                      "LEFT JOIN TextureFileData AS TFD2 ON TextureItemID2 = TFD2.ID "
-                      "WHERE ItemDisplayInfo.ID = %1").arg(m_displayId);
+      query = "SELECT MFD1.ModelID, TFD1.TextureID, MFD2.ModelID, TFD2.TextureID FROM ItemDisplayInfo "
+              "LEFT JOIN ModelFileData AS MFD1 ON Model1 = MFD1.ID "
+              "LEFT JOIN TextureFileData AS TFD1 ON TextureItemID1 = TFD1.ID "
+              "LEFT JOIN ModelFileData AS MFD2 ON Model2 = MFD2.ID "
+              "LEFT JOIN TextureFileData AS TFD2 ON TextureItemID2 = TFD2.ID "
+              "WHERE ItemDisplayInfo.ID = ?";
 
-      iteminfos = GAMEDATABASE.sqlQuery(query);
+      iteminfos = GAMEDATABASE.sqlQuery(query, QVariantList() << m_displayId);
 
       if (!iteminfos.valid || iteminfos.values.empty())
       {
@@ -445,11 +488,11 @@ void WoWItem::load()
     case CS_PANTS:
     {
       // query texture infos from ItemDisplayInfoMaterialRes
-      QString query = QString("SELECT TextureID FROM ItemDisplayInfoMaterialRes "
-                              "LEFT JOIN TextureFileData ON TextureFileDataID = TextureFileData.ID "
-                              "WHERE ItemDisplayInfoID = %1").arg(m_displayId);
+      QString query = "SELECT TextureID FROM ItemDisplayInfoMaterialRes "
+                      "LEFT JOIN TextureFileData ON TextureFileDataID = TextureFileData.ID "
+                      "WHERE ItemDisplayInfoID = ?";
 
-      sqlResult iteminfos = filterSQLResultForModel(GAMEDATABASE.sqlQuery(query), TEXTURE, 0);
+      sqlResult iteminfos = filterSQLResultForModel(GAMEDATABASE.sqlQuery(query, QVariantList() << m_displayId), TEXTURE, 0);
 
       if (!iteminfos.valid || iteminfos.values.empty())
       {
@@ -468,12 +511,12 @@ void WoWItem::load()
       }
 
       // geosets / models
-      query = QString("SELECT GeosetGroup2, GeosetGroup3, ModelID, TextureID FROM ItemDisplayInfo "
-        "LEFT JOIN ModelFileData ON Model1 = ModelFileData.ID "
-        "LEFT JOIN TextureFileData ON TextureItemID1 = TextureFileData.ID "
-        "WHERE ItemDisplayInfo.ID = %1").arg(m_displayId);
+      query = "SELECT GeosetGroup2, GeosetGroup3, ModelID, TextureID FROM ItemDisplayInfo "
+              "LEFT JOIN ModelFileData ON Model1 = ModelFileData.ID "
+              "LEFT JOIN TextureFileData ON TextureItemID1 = TextureFileData.ID "
+              "WHERE ItemDisplayInfo.ID = ?";
 
-      iteminfos = filterSQLResultForModel(GAMEDATABASE.sqlQuery(query), MERGED_MODEL, 2);
+      iteminfos = filterSQLResultForModel(GAMEDATABASE.sqlQuery(query, QVariantList() << m_displayId), MERGED_MODEL, 2);
 
       if (!iteminfos.valid || iteminfos.values.empty())
       {
@@ -493,11 +536,11 @@ void WoWItem::load()
     case CS_CHEST:
     {
       // query texture infos from ItemDisplayInfoMaterialRes
-      QString query = QString("SELECT TextureID FROM ItemDisplayInfoMaterialRes "
-                              "LEFT JOIN TextureFileData ON TextureFileDataID = TextureFileData.ID "
-                              "WHERE ItemDisplayInfoID = %1").arg(m_displayId);
+      QString query = "SELECT TextureID FROM ItemDisplayInfoMaterialRes "
+                      "LEFT JOIN TextureFileData ON TextureFileDataID = TextureFileData.ID "
+                      "WHERE ItemDisplayInfoID = ?";
 
-      sqlResult iteminfos = filterSQLResultForModel(GAMEDATABASE.sqlQuery(query), TEXTURE, 0);
+      sqlResult iteminfos = filterSQLResultForModel(GAMEDATABASE.sqlQuery(query, QVariantList() << m_displayId), TEXTURE, 0);
 
       if (!iteminfos.valid || iteminfos.values.empty())
       {
@@ -516,14 +559,14 @@ void WoWItem::load()
       }
 
       // geosets
-      query = QString("SELECT GeosetGroup1, GeosetGroup2, GeosetGroup3, ModelID, TextureID FROM ItemDisplayInfo "
-                      "LEFT JOIN ModelFileData ON Model1 = ModelFileData.ID "
-                      "LEFT JOIN TextureFileData ON TextureItemID1 = TextureFileData.ID "
-                      "WHERE ItemDisplayInfo.ID = %1").arg(m_displayId);
+      query = "SELECT GeosetGroup1, GeosetGroup2, GeosetGroup3, ModelID, TextureID FROM ItemDisplayInfo "
+              "LEFT JOIN ModelFileData ON Model1 = ModelFileData.ID "
+              "LEFT JOIN TextureFileData ON TextureItemID1 = TextureFileData.ID "
+              "WHERE ItemDisplayInfo.ID = ?";
 
       LOG_INFO << query;
 
-      iteminfos = filterSQLResultForModel(GAMEDATABASE.sqlQuery(query), MERGED_MODEL, 3);
+      iteminfos = filterSQLResultForModel(GAMEDATABASE.sqlQuery(query, QVariantList() << m_displayId), MERGED_MODEL, 3);
 
       if (!iteminfos.valid || iteminfos.values.empty())
       {
@@ -542,11 +585,11 @@ void WoWItem::load()
     case CS_BRACERS:
     {
       // query texture infos from ItemDisplayInfoMaterialRes
-      QString query = QString("SELECT TextureID FROM ItemDisplayInfoMaterialRes "
-                              "LEFT JOIN TextureFileData ON TextureFileDataID = TextureFileData.ID "
-                              "WHERE ItemDisplayInfoID = %1").arg(m_displayId);
+      QString query = "SELECT TextureID FROM ItemDisplayInfoMaterialRes "
+                      "LEFT JOIN TextureFileData ON TextureFileDataID = TextureFileData.ID "
+                      "WHERE ItemDisplayInfoID = ?";
 
-      sqlResult iteminfos = filterSQLResultForModel(GAMEDATABASE.sqlQuery(query), TEXTURE, 0);
+      sqlResult iteminfos = filterSQLResultForModel(GAMEDATABASE.sqlQuery(query, QVariantList() << m_displayId), TEXTURE, 0);
 
       if (!iteminfos.valid || iteminfos.values.empty())
       {
@@ -568,11 +611,11 @@ void WoWItem::load()
     case CS_GLOVES:
     {
       // query texture infos from ItemDisplayInfoMaterialRes
-      QString query = QString("SELECT TextureID FROM ItemDisplayInfoMaterialRes "
-                              "LEFT JOIN TextureFileData ON TextureFileDataID = TextureFileData.ID "
-                              "WHERE ItemDisplayInfoID = %1").arg(m_displayId);
+      QString query = "SELECT TextureID FROM ItemDisplayInfoMaterialRes "
+                      "LEFT JOIN TextureFileData ON TextureFileDataID = TextureFileData.ID "
+                      "WHERE ItemDisplayInfoID = ?";
 
-      sqlResult iteminfos = filterSQLResultForModel(GAMEDATABASE.sqlQuery(query), TEXTURE, 0);
+      sqlResult iteminfos = filterSQLResultForModel(GAMEDATABASE.sqlQuery(query, QVariantList() << m_displayId), TEXTURE, 0);
 
       if (!iteminfos.valid || iteminfos.values.empty())
       {
@@ -591,12 +634,12 @@ void WoWItem::load()
       }
 
       // now get geoset / model infos
-      query = QString("SELECT GeoSetGroup1, ModelID, TextureID  FROM ItemDisplayInfo "
-                      "LEFT JOIN ModelFileData ON Model1 = ModelFileData.ID "
-                      "LEFT JOIN TextureFileData ON TextureItemID1 = TextureFileData.ID "
-                      "WHERE ItemDisplayInfo.ID = %1").arg(m_displayId);
+      query = "SELECT GeoSetGroup1, ModelID, TextureID  FROM ItemDisplayInfo "
+              "LEFT JOIN ModelFileData ON Model1 = ModelFileData.ID "
+              "LEFT JOIN TextureFileData ON TextureItemID1 = TextureFileData.ID "
+              "WHERE ItemDisplayInfo.ID = ?";
 
-      iteminfos = filterSQLResultForModel(GAMEDATABASE.sqlQuery(query), MERGED_MODEL, 1);
+      iteminfos = filterSQLResultForModel(GAMEDATABASE.sqlQuery(query, QVariantList() << m_displayId), MERGED_MODEL, 1);
 
       if (!iteminfos.valid || iteminfos.values.empty())
       {
@@ -614,12 +657,12 @@ void WoWItem::load()
     case CS_HAND_RIGHT:
     case CS_HAND_LEFT:
     {
-      QString query = QString("SELECT ModelID, TextureID FROM ItemDisplayInfo "
-                              "LEFT JOIN ModelFileData ON Model1 = ModelFileData.ID "
-                              "LEFT JOIN TextureFileData ON TextureItemID1 = TextureFileData.ID "
-                              "WHERE ItemDisplayInfo.ID = %1").arg(m_displayId);
+      QString query = "SELECT ModelID, TextureID FROM ItemDisplayInfo "
+                      "LEFT JOIN ModelFileData ON Model1 = ModelFileData.ID "
+                      "LEFT JOIN TextureFileData ON TextureItemID1 = TextureFileData.ID "
+                      "WHERE ItemDisplayInfo.ID = ?";
 
-      sqlResult iteminfos = GAMEDATABASE.sqlQuery(query);
+      sqlResult iteminfos = GAMEDATABASE.sqlQuery(query, QVariantList() << m_displayId);
 
       if (!iteminfos.valid || iteminfos.values.empty())
       {
@@ -633,12 +676,12 @@ void WoWItem::load()
     }
     case CS_CAPE:
     {
-      QString query = QString("SELECT TextureID, GeosetGroup1 FROM ItemDisplayInfo "
-                              "LEFT JOIN TextureFileData ON TextureItemID1 = TextureFileData.ID "
-                              "WHERE ItemDisplayInfo.ID = %1").arg(m_displayId);
+      QString query = "SELECT TextureID, GeosetGroup1 FROM ItemDisplayInfo "
+                      "LEFT JOIN TextureFileData ON TextureItemID1 = TextureFileData.ID "
+                      "WHERE ItemDisplayInfo.ID = ?";
 
 
-      sqlResult iteminfos = GAMEDATABASE.sqlQuery(query);
+      sqlResult iteminfos = GAMEDATABASE.sqlQuery(query, QVariantList() << m_displayId);
 
       if (!iteminfos.valid || iteminfos.values.empty())
       {
@@ -711,11 +754,11 @@ void WoWItem::load()
         m_charModel->td.showCustom = false;
 
         // query texture infos from ItemDisplayInfoMaterialRes
-        QString query = QString("SELECT TextureID FROM ItemDisplayInfoMaterialRes "
-                                "LEFT JOIN TextureFileData ON TextureFileDataID = TextureFileData.ID "
-                                "WHERE ItemDisplayInfoID = %1").arg(m_displayId);
+        QString query = "SELECT TextureID FROM ItemDisplayInfoMaterialRes "
+                        "LEFT JOIN TextureFileData ON TextureFileDataID = TextureFileData.ID "
+                        "WHERE ItemDisplayInfoID = ?";
 
-        sqlResult iteminfos = filterSQLResultForModel(GAMEDATABASE.sqlQuery(query), TEXTURE, 0);
+        sqlResult iteminfos = filterSQLResultForModel(GAMEDATABASE.sqlQuery(query, QVariantList() << m_displayId), TEXTURE, 0);
 
         if (!iteminfos.valid || iteminfos.values.empty())
         {
@@ -734,10 +777,10 @@ void WoWItem::load()
         }
 
         // geosets
-        query = QString("SELECT GeosetGroup1 FROM ItemDisplayInfo "
-                        "WHERE ItemDisplayInfo.ID = %1").arg(m_displayId);
+        query = "SELECT GeosetGroup1 FROM ItemDisplayInfo "
+                "WHERE ItemDisplayInfo.ID = ?";
 
-        iteminfos = GAMEDATABASE.sqlQuery(query);
+        iteminfos = GAMEDATABASE.sqlQuery(query, QVariantList() << m_displayId);
 
         if (!iteminfos.valid || iteminfos.values.empty())
         {
@@ -459,41 +459,37 @@ void WoWModel::initCommon(GameFile * f)
     return;
   }
 
-  if (f->isChunked() && f->setChunk("SKID"))
+  prefetchDependencies(f);
+
+  uint32 skelFileID;
+  if (f->chunk<uint32>(core::fourcc("SKID")).get(0, skelFileID))
   {
-    uint32 skelFileID;
-    f->read(&skelFileID, sizeof(skelFileID));
     GameFile * skelFile = GAMEDIRECTORY.getFile(skelFileID);
 
-    if (skelFile->open())
+    if (skelFile && skelFile->open())
     {
-      if (skelFile->setChunk("SKS1"))
-      {
-        SKS1 sks1;
-        memcpy(&sks1, skelFile->getBuffer(), sizeof(SKS1));
+      core::ChunkView<unsigned char> skelChunk = skelFile->chunk<unsigned char>(core::fourcc("SKS1"));
+      SKS1 sks1;
 
-        if (sks1.nGlobalSequences > 0)
-          globalSequences.assign(skelFile->getBuffer() + sks1.ofsGlobalSequences, skelFile->getBuffer() + sks1.ofsGlobalSequences + sks1.nGlobalSequences);
+      if (skelChunk.sub<SKS1>(0, 1).get(0, sks1))
+      {
+        core::ChunkView<uint32> sequences = skelChunk.sub<uint32>(sks1.ofsGlobalSequences, sks1.nGlobalSequences);
+        globalSequences.assign(sequences.begin(), sequences.end());
 
         // let's try to read parent skel file if needed
-        if (skelFile->setChunk("SKPD"))
+        SKPD skpd;
+        if (skelFile->chunk<SKPD>(core::fourcc("SKPD")).get(0, skpd))
         {
-          SKPD skpd;
-          memcpy(&skpd, skelFile->getBuffer(), sizeof(SKPD));
-
           GameFile * parentFile = GAMEDIRECTORY.getFile(skpd.parentFileId);
 
-          if (parentFile && parentFile->open() && parentFile->setChunk("SKS1"))
+          if (parentFile && parentFile->open())
           {
-            SKS1 sks1;
-            memcpy(&sks1, parentFile->getBuffer(), sizeof(SKS1));
+            core::ChunkView<unsigned char> parentChunk = parentFile->chunk<unsigned char>(core::fourcc("SKS1"));
 
-            if (sks1.nGlobalSequences > 0)
+            if (parentChunk.sub<SKS1>(0, 1).get(0, sks1))
             {
-              uint32 * buffer = new uint32[sks1.nGlobalSequences];
-              memcpy(buffer, parentFile->getBuffer() + sks1.ofsGlobalSequences, sizeof(uint32)*sks1.nGlobalSequences);
-              for (uint i = 0; i < sks1.nGlobalSequences; i++)
-                globalSequences.push_back(buffer[i]);
+              sequences = parentChunk.sub<uint32>(sks1.ofsGlobalSequences, sks1.nGlobalSequences);
+              globalSequences.insert(globalSequences.end(), sequences.begin(), sequences.end());
             }
 
             parentFile->close();
@@ -503,11 +499,11 @@ void WoWModel::initCommon(GameFile * f)
       }
       skelFile->close();
     }
-    f->setChunk("MD21");
   }
   else if (header.nGlobalSequences)
   {
-    globalSequences.assign(f->getBuffer() + header.ofsGlobalSequences, f->getBuffer() + header.ofsGlobalSequences + header.nGlobalSequences);
+    uint32 * sequences = (uint32 *)(f->getBuffer() + header.ofsGlobalSequences);
+    globalSequences.assign(sequences, sequences + header.nGlobalSequences);
   }
 
   if (forceAnim)
@@ -624,45 +620,35 @@ void WoWModel::initCommon(GameFile * f)
   }
   */
 
-  if (f->isChunked() && f->setChunk("SKID"))
+  if (f->chunk<uint32>(core::fourcc("SKID")).get(0, skelFileID))
   {
-    uint32 skelFileID;
-    f->read(&skelFileID, sizeof(skelFileID));
     GameFile * skelFile = GAMEDIRECTORY.getFile(skelFileID);
 
-    if (skelFile->open())
+    if (skelFile && skelFile->open())
     {
-      if (skelFile->setChunk("SKA1"))
+      core::ChunkView<unsigned char> skelChunk = skelFile->chunk<unsigned char>(core::fourcc("SKA1"));
+      SKA1 ska1;
+
+      if (skelChunk.sub<SKA1>(0, 1).get(0, ska1))
       {
-        SKA1 ska1;
-        memcpy(&ska1, skelFile->getBuffer(), sizeof(SKA1));
         header.nAttachments = ska1.nAttachments;
-        ModelAttachmentDef *attachments = (ModelAttachmentDef*)(skelFile->getBuffer() + ska1.ofsAttachments);
-        for (size_t i = 0; i < ska1.nAttachments; i++)
+        for (auto & it : skelChunk.sub<ModelAttachmentDef>(ska1.ofsAttachments, ska1.nAttachments))
         {
           ModelAttachment att;
           att.model = this;
-          att.init(attachments[i]);
+          att.init(it);
           atts.push_back(att);
         }
 
         header.nAttachLookup = ska1.nAttachLookup;
-        if (ska1.nAttachLookup > 0)
-        {
-          int16 *p = (int16*)(skelFile->getBuffer() + ska1.ofsAttachLookup);
-          if (ska1.nAttachLookup > ATT_MAX)
-            LOG_ERROR << "Model AttachLookup" << ska1.nAttachLookup << "over" << ATT_MAX;
-          for (size_t i = 0; i < ska1.nAttachLookup; i++)
-          {
-            if (i > ATT_MAX - 1)
-              break;
-            attLookup[i] = p[i];
-          }
-        }
+        core::ChunkView<int16> lookup = skelChunk.sub<int16>(ska1.ofsAttachLookup, ska1.nAttachLookup);
+        if (lookup.size() > ATT_MAX)
+          LOG_ERROR << "Model AttachLookup" << lookup.size() << "over" << ATT_MAX;
+        for (size_t i = 0; i < lookup.size() && i < ATT_MAX; i++)
+          attLookup[i] = lookup[i];
       }
       skelFile->close();
     }
-    f->setChunk("MD21");
   }
   else
   {
@@ -734,6 +720,43 @@ void WoWModel::initCommon(GameFile * f)
   f->close();
 }
 
+// ask game folder to decode in background files this model will open during its initialization
+// (skins, skeleton, animations, textures), so that decompression overlaps with model parsing
+void WoWModel::prefetchDependencies(GameFile * f)
+{
+  std::vector<int> ids;
+
+  // chunks listing file ids (views are empty if chunk doesn't exist)
+  for (auto id : f->chunk<uint32>(core::fourcc("SFID")))
+    ids.push_back(id);
+
+  for (auto id : f->chunk<uint32>(core::fourcc("SKID")))
+    ids.push_back(id);
+
+  for (auto id : f->chunk<uint32>(core::fourcc("TXID")))
+    ids.push_back(id);
+
+  for (auto & it : f->chunk<AFID>(core::fourcc("AFID")))
+    ids.push_back(it.fileId);
+
+  ids.erase(std::remove(ids.begin(), ids.end(), 0), ids.end());
+
+  // textures referenced by name
+  ModelTextureDef *texdef = (ModelTextureDef*)(f->getBuffer() + header.ofsTextures);
+  for (size_t i = 0; i < header.nTextures; i++)
+  {
+    if (texdef[i].type != TEXTURE_FILENAME || texdef[i].nameOfs == 0)
+      continue;
+
+    GameFile * tex = GAMEDIRECTORY.getFile(QString((char*)(f->getBuffer() + texdef[i].nameOfs)));
+    if (tex)
+      ids.push_back(tex->fileDataId());
+  }
+
+  if (!ids.empty())
+    GAMEDIRECTORY.prefetch(ids);
+}
+
 void WoWModel::initStatic(GameFile * f)
 {
   dlist = glGenLists(1);
@@ -753,15 +776,10 @@ vector<AFID> WoWModel::readAFIDSFromFile(GameFile * f)
 {
   vector<AFID> afids;
 
-  if (f->setChunk("AFID"))
+  for (auto & it : f->chunk<AFID>(core::fourcc("AFID")))
   {
-    AFID afid;
-    while (!f->isEof())
-    {
-      f->read(&afid, sizeof(AFID));
-      if (afid.fileId != 0)
-        afids.push_back(afid);
-    }
+    if (it.fileId != 0)
+      afids.push_back(it);
   }
 
   return afids;
@@ -769,6 +787,15 @@ vector<AFID> WoWModel::readAFIDSFromFile(GameFile * f)
 
 void WoWModel::readAnimsFromFile(GameFile * f, vector<AFID> & afids, uint32 nAnimations, uint32 ofsAnimation, uint32 nAnimationLookup, uint32 ofsAnimationLookup)
 {
+  // decode anim files in background while we go through animations below
+  if (afids.size() > 0)
+  {
+    std::vector<int> ids;
+    for (auto it : afids)
+      ids.push_back(it.fileId);
+    GAMEDIRECTORY.prefetch(ids);
+  }
+
   for (uint i = 0; i < nAnimations; i++)
   {
     ModelAnimation a;
@@ -825,13 +852,12 @@ void WoWModel::readAnimsFromFile(GameFile * f, vector<AFID> & afids, uint32 nAni
 
 void WoWModel::initAnimated(GameFile * f)
 {
-  if (f->isChunked() && f->setChunk("SKID"))
+  uint32 skelFileID;
+  if (f->chunk<uint32>(core::fourcc("SKID")).get(0, skelFileID))
   {
-    uint32 skelFileID;
-    f->read(&skelFileID, sizeof(skelFileID));
     GameFile * skelFile = GAMEDIRECTORY.getFile(skelFileID);
 
-    if (skelFile->open())
+    if (skelFile && skelFile->open())
     {
       skelFile->dumpStructure();
       vector<AFID> afids = readAFIDSFromFile(skelFile);
@@ -895,17 +921,10 @@ void WoWModel::initAnimated(GameFile * f)
       }
       skelFile->close();
     }
-    f->setChunk("MD21", false);
   }
   else if (header.nAnimations > 0)
   {
-    vector<AFID> afids;
-  
-    if (f->isChunked() && f->setChunk("AFID"))
-    {
-      afids = readAFIDSFromFile(f);
-      f->setChunk("MD21", false);
-    }
+    vector<AFID> afids = readAFIDSFromFile(f);
 
     readAnimsFromFile(f, afids, header.nAnimations, header.ofsAnimations, header.nAnimationLookup, header.ofsAnimationLookup);
 
@@ -74,6 +74,7 @@ class _WOWMODEL_API_ WoWModel : public ManagedItem, public Displayable, public M
 
   inline void drawModel();
   void initCommon(GameFile * f);
+  void prefetchDependencies(GameFile * f);
   bool isAnimated(GameFile * f);
   void initAnimated(GameFile * f);
   void initStatic(GameFile * f);
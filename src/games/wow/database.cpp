@@ -1,6 +1,7 @@
 #include "database.h"
 
 #include "globalvars.h"
+#include "SqlQuery.h"
 #include "wow_enums.h"
 #include "logger/Logger.h"
 
@@ -26,7 +27,29 @@ ItemRecord::ItemRecord(const std::vector<QString> & vals)
   subclass = vals[4].toInt();
   model = 1;
   quality = vals[6].toInt();
-  switch(vals[5].toInt())
+  setSheath(vals[5].toInt());
+  name = vals[1];
+}
+
+ItemRecord::ItemRecord(const core::SqlQuery & row)
+  : id(0), itemclass(0), subclass(0), type(0), model(0), sheath(0), quality(0)
+{
+  if(row.columnCount() < 7)
+      return;
+
+  id = row.integer(0);
+  type = row.integer(2);
+  itemclass = row.integer(3);
+  subclass = row.integer(4);
+  model = 1;
+  quality = row.integer(6);
+  setSheath(row.integer(5));
+  name = row.text(1);
+}
+
+void ItemRecord::setSheath(int sheathType)
+{
+  switch(sheathType)
   {
     case SHEATHETYPE_MAINHAND: sheath = ATT_LEFT_BACK_SHEATH; break;
     case SHEATHETYPE_LARGEWEAPON: sheath = ATT_LEFT_BACK; break;
@@ -34,7 +57,6 @@ ItemRecord::ItemRecord(const std::vector<QString> & vals)
     case SHEATHETYPE_SHIELD: sheath = ATT_MIDDLE_BACK_SHEATH; break;
     default: sheath = SHEATHETYPE_NONE;
   }
-  name = vals[1];
 }
 
 int ItemRecord::slot()
@@ -136,3 +158,15 @@ NPCRecord::NPCRecord(const std::vector<QString> & vals)
   type = vals[2].toInt();
   name = vals[3];
 }
+
+NPCRecord::NPCRecord(const core::SqlQuery & row)
+    : id(0), model(0), type(0)
+{
+  if(row.columnCount() < 4)
+    return;
+
+  id = row.integer(0);
+  model = row.integer(1);
+  type = row.integer(2);
+  name = row.text(3);
+}
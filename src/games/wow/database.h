@@ -23,6 +23,11 @@
 class ItemDatabase;
 struct NPCRecord;
 
+namespace core
+{
+  class SqlQuery;
+}
+
 #ifdef _WIN32
 #    ifdef BUILDING_WOW_DLL
 #        define _DATABASE_API_ __declspec(dllexport)
@@ -49,10 +54,15 @@ struct _DATABASE_API_ ItemRecord {
 	int id, itemclass, subclass, type, model, sheath, quality;
 
 	ItemRecord(const std::vector<QString> &);
+	// from current row of a query, with same columns as above
+	ItemRecord(const core::SqlQuery &);
 	ItemRecord():id(0), itemclass(-1), subclass(-1), type(0), model(0), sheath(0), quality(0)
 	{}
 
 	int slot();
+
+private:
+	void setSheath(int sheathType);
 };
 
 class _DATABASE_API_ ItemDatabase {
@@ -78,6 +88,7 @@ struct _DATABASE_API_ NPCRecord
 
 	NPCRecord(QString line);
 	NPCRecord(const std::vector<QString> &);
+	NPCRecord(const core::SqlQuery &);
 	NPCRecord(): id(0), model(0), type(0) {}
 	NPCRecord(const NPCRecord &r): name(r.name), id(r.id), model(r.model), type(r.type) {}
 
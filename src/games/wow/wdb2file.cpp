@@ -82,6 +82,13 @@ bool WDB2File::open()
   data = getPointer();
   stringTable = data + recordSize*recordCount;
 
+  // first field of records is their id
+  std::vector<unsigned int> ids(recordCount);
+  for (unsigned int i = 0; i < recordCount; i++)
+    ids[i] = getUInt(data + i*recordSize, 0);
+
+  setRecordIds(ids);
+
   return true;
 }
 
@@ -166,4 +173,42 @@ std::vector<std::string> WDB2File::get(unsigned int recordIndex, const core::Tab
     }
   }
   return result;
-}
\ No newline at end of file
+}
+
+void WDB2File::writeRecord(unsigned int recordIndex, const core::TableStructure * structure, DBRecordWriter & writer) const
+{
+  unsigned char * recordOffset = data + (recordIndex * recordSize);
+  unsigned int offset = 0; // to handle byte reading, incremented each time a byte member is read
+  for (auto it : structure->fields)
+  {
+    if (it->type == "uint")
+    {
+      writer.writeInt(getUInt(recordOffset, it->id));
+    }
+    else if (it->type == "int")
+    {
+      writer.writeInt(getInt(recordOffset, it->id));
+    }
+    else if (it->type == "text")
+    {
+      size_t stringOffset = getUInt(recordOffset, it->id);
+      if (stringOffset >= stringSize)
+        stringOffset = 0;
+
+      const char * val = reinterpret_cast<const char *>(stringTable + stringOffset);
+      writer.writeText(val, (int)strlen(val));
+    }
+    else if (it->type == "float")
+    {
+      writer.writeReal(getFloat(recordOffset, it->id));
+    }
+    else if (it->type == "byte")
+    {
+      // bytes are packed from most significant one, see get()
+      unsigned int decal = (offset < 3) ? 24 - offset * 8 : 0;
+      unsigned int val = getUInt(recordOffset, it->id - offset);
+      writer.writeInt((val >> decal) & 0x000000FF);
+      offset++;
+    }
+  }
+}
@@ -55,6 +55,7 @@ public:
   }
 
   std::vector<std::string> get(unsigned int recordIndex, const core::TableStructure * structure) const;
+  void writeRecord(unsigned int recordIndex, const core::TableStructure * structure, DBRecordWriter & writer) const;
 
 private:
 };
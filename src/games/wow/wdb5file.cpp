@@ -2,16 +2,17 @@
 
 #include "logger/Logger.h"
 
-#include <sstream>
-
+#include <algorithm>
 #include <bitset>
+#include <cstring>
+#include <vector>
 
 #include "WoWDatabase.h"
 
 #define WDB5_READ_DEBUG 0
 
 WDB5File::WDB5File(const QString & file) :
-DBFile(), m_isSparseTable(false), CASCFile(file)
+DBFile(), m_isSparseTable(false), CASCFile(file), m_layoutStructure(0)
 {
 }
 
@@ -53,8 +54,8 @@ bool WDB5File::open()
   recordCount = header.record_count;
   fieldCount = header.field_count;
 
-  field_structure * fieldStructure = new field_structure[fieldCount];
-  read(fieldStructure, fieldCount * sizeof(field_structure));
+  std::vector<field_structure> fieldStructure(fieldCount);
+  read(fieldStructure.data(), fieldCount * sizeof(field_structure));
 #if WDB5_READ_DEBUG > 0
   LOG_INFO << "--------------------------";
 #endif
@@ -156,10 +157,9 @@ bool WDB5File::open()
       // read ids from data
       for (uint i = 0; i < recordCount; i++)
       {
-        unsigned char * recordOffset = data + (i*recordSize);
-        unsigned char * val = new unsigned char[indexSize];
-        memcpy(val, recordOffset + indexPos, indexSize);
-        m_IDs.push_back((*reinterpret_cast<unsigned int*>(val)& indexMask));
+        uint32 val = 0;
+        memcpy(&val, data + (i*recordSize) + indexPos, indexSize);
+        m_IDs.push_back(val & indexMask);
       }
     }
 
@@ -178,27 +178,31 @@ bool WDB5File::open()
 
     copy_table_entry * copyTable = new copy_table_entry[nbEntries];
     read(copyTable, header.copy_table_size);
-    
-    // create a id->offset map
-    std::map<uint32, unsigned char*> IDToOffsetMap;
 
-    for (uint i = 0; i < recordCount; i++)
-    {
-      IDToOffsetMap[m_IDs[i]] = m_recordOffsets[i];
-    }
+    // copied rows alias their source record, found through id index of records read so far
+    setRecordIds(m_IDs);
 
     for (uint i = 0; i < nbEntries; i++)
     {
       copy_table_entry entry = copyTable[i];
+      unsigned int source = findById(entry.copiedRowId);
+
+      if (source == npos)
+      {
+        LOG_ERROR << "Copied row" << entry.copiedRowId << "not found in" << fullname();
+        continue;
+      }
+
       m_IDs.push_back(entry.newRowId);
-      m_recordOffsets.push_back(IDToOffsetMap[entry.copiedRowId]);
+      m_recordOffsets.push_back(m_recordOffsets[source]);
+      recordCount++;
     }
 
     delete[] copyTable;
-
-    recordCount += nbEntries;
   }
 
+  setRecordIds(m_IDs);
+
 #if WDB5_READ_DEBUG > 0
   LOG_INFO << "End of" << __FUNCTION__;
 #endif
@@ -211,82 +215,152 @@ bool WDB5File::close()
   return CASCFile::close();
 }
 
-WDB5File::~WDB5File()
-{
-  close();
-}
-
-std::vector<std::string> WDB5File::get(unsigned int recordIndex, const core::TableStructure * structure) const
+const std::vector<WDB5File::FieldLayout> & WDB5File::layout(const core::TableStructure * structure) const
 {
-  std::vector<std::string> result;
+  if (structure == m_layoutStructure)
+    return m_layout;
 
-  unsigned char * recordOffset = m_recordOffsets[recordIndex];
+  m_layout.clear();
+  m_layoutStructure = structure;
 
   for (auto it : structure->fields)
   {
     wow::FieldStructure * field = dynamic_cast<wow::FieldStructure *>(it);
 
+    if (!field)
+      continue;
+
+    FieldLayout l;
+    l.offset = 0;
+    l.size = 0;
+    l.shift = 0;
+    l.column = -1;
+
     if (field->isKey)
     {
-      std::stringstream ss;
+      l.type = FieldLayout::KEY_FIELD;
+      m_layout.push_back(l);
+      continue;
+    }
 
-      ss << m_IDs[recordIndex];
+    if (field->isCommonData)
+    {
+      l.type = FieldLayout::COMMON_DATA_FIELD;
+      l.column = field->pos;
+      m_layout.push_back(l);
+      continue;
+    }
 
-      result.push_back(ss.str());
+    if (field->type == "text")
+      l.type = FieldLayout::TEXT_FIELD;
+    else if (field->type == "float")
+      l.type = FieldLayout::FLOAT_FIELD;
+    else if (field->type == "int")
+      l.type = FieldLayout::INT_FIELD;
+    else
+      l.type = FieldLayout::UINT_FIELD;
 
-      continue;
+    auto size = m_fieldSizes.find(field->pos);
+    if (size == m_fieldSizes.end())
+    {
+      LOG_ERROR << "No field at position" << field->pos << "in" << fullname() << "- field" << field->name << "read on 4 bytes";
+      l.size = 4;
+    }
+    else
+    {
+      l.size = (32 - size->second) / 8;
     }
 
-    if (field->isCommonData) // managed in wdb6 reader
-      continue;
+    l.shift = 32 - l.size * 8;
 
     for (uint i = 0; i < field->arraySize; i++)
     {
-      int fieldSize = (32 - m_fieldSizes.at(field->pos)) / 8;
-      unsigned char * val = new unsigned char[fieldSize];
+      l.offset = field->pos + i*l.size;
+      m_layout.push_back(l);
+    }
+  }
 
-      memcpy(val, recordOffset + field->pos + i*fieldSize, fieldSize);
+  return m_layout;
+}
 
-      if (field->type == "text")
+void WDB5File::decodeRecord(unsigned int recordIndex, const std::vector<FieldLayout> & layout, DBRecordWriter & writer) const
+{
+  const unsigned char * recordOffset = m_recordOffsets[recordIndex];
+
+  for (const FieldLayout & field : layout)
+  {
+    if (field.type == FieldLayout::KEY_FIELD)
+    {
+      writer.writeInt(m_IDs[recordIndex]);
+      continue;
+    }
+
+    if (field.type == FieldLayout::COMMON_DATA_FIELD)
+    {
+      writeCommonData(recordIndex, field.column, writer);
+      continue;
+    }
+
+    uint32 val = 0;
+    memcpy(&val, recordOffset + field.offset, field.size);
+
+    switch (field.type)
+    {
+      case FieldLayout::TEXT_FIELD:
       {
-        char * stringPtr;
+        const char * stringPtr;
         if (m_isSparseTable)
-          stringPtr = reinterpret_cast<char *>(recordOffset + field->pos);
+          stringPtr = reinterpret_cast<const char *>(recordOffset + field.offset);
         else
-          stringPtr = reinterpret_cast<char *>(stringTable + *reinterpret_cast<int *>(val));
+          stringPtr = reinterpret_cast<const char *>(stringTable + val);
 
-        std::string value(stringPtr);
-        std::replace(value.begin(), value.end(), '"', '\'');
-        result.push_back(value);
-      }
-      else if (field->type == "float")
-      {
-        std::stringstream ss;
-        ss << *reinterpret_cast<float*>(val);
-        result.push_back(ss.str());
+        writer.writeText(stringPtr, (int)strlen(stringPtr));
+        break;
       }
-      else if (field->type == "int")
+      case FieldLayout::FLOAT_FIELD:
       {
-        std::stringstream ss;
-        ss << (*reinterpret_cast<int*>(val));
-        result.push_back(ss.str());
-      }
-      else
-      {
-        unsigned int mask = 0xFFFFFFFF;
-        if (fieldSize == 1)
-          mask = 0x000000FF;
-        else if (fieldSize == 2)
-          mask = 0x0000FFFF;
-        else if (fieldSize == 3)
-          mask = 0x00FFFFFF;
-
-        std::stringstream ss;
-        ss << (*reinterpret_cast<unsigned int*>(val)& mask);
-        result.push_back(ss.str());
+        float f;
+        memcpy(&f, &val, sizeof(f));
+        writer.writeReal(f);
+        break;
       }
+      case FieldLayout::INT_FIELD:
+        writer.writeInt(static_cast<int>(val << field.shift) >> field.shift);
+        break;
+      default:
+        writer.writeInt(val);
+        break;
     }
   }
+}
+
+void WDB5File::decodeRange(unsigned int begin, unsigned int end, const core::TableStructure * structure, DBRecordWriter & writer) const
+{
+  const std::vector<FieldLayout> & fields = layout(structure);
+
+  for (unsigned int record = begin; record < end; record++)
+  {
+    writer.beginRecord(record);
+    decodeRecord(record, fields, writer);
+  }
+}
+
+void WDB5File::writeRecord(unsigned int recordIndex, const core::TableStructure * structure, DBRecordWriter & writer) const
+{
+  decodeRecord(recordIndex, layout(structure), writer);
+}
+
+WDB5File::~WDB5File()
+{
+  close();
+}
+
+std::vector<std::string> WDB5File::get(unsigned int recordIndex, const core::TableStructure * structure) const
+{
+  std::vector<std::string> result;
+
+  DBStringWriter writer(result);
+  decodeRecord(recordIndex, layout(structure), writer);
 
   return result;
 }
@@ -50,11 +50,41 @@ public:
   virtual header readHeader();
 
   virtual std::vector<std::string> get(unsigned int recordIndex, const core::TableStructure * structure) const;
+  virtual void writeRecord(unsigned int recordIndex, const core::TableStructure * structure, DBRecordWriter & writer) const;
+  virtual void decodeRange(unsigned int begin, unsigned int end, const core::TableStructure * structure, DBRecordWriter & writer) const;
 
 protected:
+  // value of a common data field for given record (see WDB6File), always exactly one value.
+  // wdb5 files have none, 0 is written
+  virtual void writeCommonData(unsigned int /* recordIndex */, int /* column */, DBRecordWriter & writer) const { writer.writeInt(0); }
+
   std::vector<uint32> m_IDs;
 
 private:
+  // where and how to read a column in records, array fields being expanded
+  struct FieldLayout
+  {
+    enum Type
+    {
+      KEY_FIELD,
+      UINT_FIELD,
+      INT_FIELD,
+      FLOAT_FIELD,
+      TEXT_FIELD,
+      COMMON_DATA_FIELD
+    };
+
+    Type type;
+    uint32 offset; // in record
+    uint32 size; // in bytes
+    int shift; // to sign extend int fields stored on less than 4 bytes
+    int column; // common data column
+  };
+
+  // layout is compiled once per table structure, so that decoding a record needs no lookup, cast or allocation
+  const std::vector<FieldLayout> & layout(const core::TableStructure * structure) const;
+  void decodeRecord(unsigned int recordIndex, const std::vector<FieldLayout> & layout, DBRecordWriter & writer) const;
+
   struct field_structure
   {
     int16 size;
@@ -71,6 +101,9 @@ private:
   std::vector<unsigned char *> m_recordOffsets;
 
   bool m_isSparseTable;
+
+  mutable std::vector<FieldLayout> m_layout;
+  mutable const core::TableStructure * m_layoutStructure;
 };
 
 #endif
@@ -4,9 +4,8 @@
 
 #include "Game.h" // GAMEDIRECTORY Singleton
 
-#include <sstream>
-
 #include <bitset>
+#include <cstring>
 
 #include "WoWDatabase.h"
 
@@ -52,6 +51,13 @@ bool WDB6File::open()
     uint32 nbcolumns;
     read(&nbcolumns, sizeof(nbcolumns));
 
+    m_commonData.resize(nbcolumns);
+
+    // starting from 7.3 version, data in common data is stored in 4 bytes, not dynamic size anymore
+    bool fixedSize = GAMEDIRECTORY.version().contains("7.3");
+
+    std::vector<unsigned char> entries;
+
     for (uint c = 0; c < nbcolumns; c++)
     {
       // read number of records
@@ -62,15 +68,13 @@ bool WDB6File::open()
       uint8 type;
       read(&type, sizeof(type));
 
+      m_commonData[c].type = type;
+
       if (nbrecords == 0)
         continue;
 
-      std::map<uint32, uint32> values;
-
       uint32 size = 4;
-
-      // starting from 7.3 version, data in common data is stored in 4 bytes, not dynamic size anymore
-      if (!GAMEDIRECTORY.version().contains("7.3"))
+      if (!fixedSize)
       {
         if (type == 1)
           size = 2;
@@ -78,23 +82,30 @@ bool WDB6File::open()
           size = 1;
       }
 
-      for (uint i = 0; i < nbrecords; i++)
+      // whole column is read at once, then spread over records through id index
+      uint32 entrySize = sizeof(uint32) + size;
+      entries.resize(nbrecords * entrySize);
+      read(entries.data(), entries.size());
+
+      std::vector<uint32> & values = m_commonData[c].values;
+      values.assign(recordCount, 0);
+
+      for (const unsigned char * entry = entries.data(), * entriesEnd = entry + entries.size(); entry < entriesEnd; entry += entrySize)
       {
         uint32 id;
-        read(&id, sizeof(id));
+        memcpy(&id, entry, sizeof(id));
 
-        uint32 val = 0;
-        read(&val, size);
+        unsigned int record = findById(id);
+        if (record == npos)
+          continue;
 
-        values[id] = val;
+        uint32 val = 0;
+        memcpy(&val, entry + sizeof(id), size);
+        values[record] = val;
       }
-
-      std::tuple<std::map<uint32, uint32>, uint8> column = std::make_tuple(values, type);
-      m_commonData[c] = column;
-
     }
   }
-  
+
   return true;
 }
 
@@ -103,61 +114,33 @@ bool WDB6File::close()
   return WDB5File::close();
 }
 
-std::vector<std::string> WDB6File::get(unsigned int recordIndex, const core::TableStructure * structure) const
+void WDB6File::writeCommonData(unsigned int recordIndex, int column, DBRecordWriter & writer) const
 {
-  std::vector<std::string> result = WDB5File::get(recordIndex, structure);
-
-  for (auto it : structure->fields)
+  // exactly one value per field, whatever the file holds : writers bind values by position
+  if (column < 0 || column >= (int)m_commonData.size())
   {
-    wow::FieldStructure * field = dynamic_cast<wow::FieldStructure *>(it);
-
-    if (!field)
-      continue;
-
-    if (field->isCommonData)
-    {
-      auto common = m_commonData.find(field->pos);
-      if (common != m_commonData.end())
-      {
-        auto val = std::get<0>(common->second).find(m_IDs[recordIndex]);
-        if (val != std::get<0>(common->second).end())
-        {
-          uint8 type = std::get<1>(common->second);
-          if (type == 1)
-          {
-            std::stringstream ss;
-            ss << static_cast<short>(val->second);
-            result.push_back(ss.str());
-          }
-          else if (type == 2)
-          {
-            std::stringstream ss;
-            ss << (static_cast<unsigned int>(val->second) & 0x000000FF);
-            result.push_back(ss.str());
-          }
-          else if (type == 3)
-          {
-            std::stringstream ss;
-            ss << static_cast<float>(val->second);
-            result.push_back(ss.str());
-          }
-          else if (type == 4)
-          {
-            std::stringstream ss;
-            ss << static_cast<int>(val->second);
-            result.push_back(ss.str());
-          }
-        }
-        else // if no value defined, insert 0
-        {
-          result.push_back("0");
-        }
-      }
-    }
+    writer.writeInt(0);
+    return;
   }
 
+  const CommonDataColumn & common = m_commonData[column];
+  uint32 val = (recordIndex < common.values.size()) ? common.values[recordIndex] : 0; // 0 if no value defined
 
-  return result;
+  if (common.type == 1)
+    writer.writeInt(static_cast<short>(val));
+  else if (common.type == 2)
+    writer.writeInt(val & 0x000000FF);
+  else if (common.type == 3)
+  {
+    // value holds float bits, as FLOAT_FIELD values in WDB5File::decodeRecord
+    float f;
+    memcpy(&f, &val, sizeof(f));
+    writer.writeReal(f);
+  }
+  else if (common.type == 4)
+    writer.writeInt(static_cast<int>(val));
+  else
+    writer.writeInt(0);
 }
 
 WDB6File::~WDB6File()
@@ -37,14 +37,23 @@ public:
 
   WDB5File::header readHeader();
 
-  std::vector<std::string> get(unsigned int recordIndex, const core::TableStructure * structure) const;
+protected:
+  void writeCommonData(unsigned int recordIndex, int column, DBRecordWriter & writer) const;
 
 private:
 
   header m_header;
-  
-  // Common data values => map[column id] => (tuple(map[id] => value (raw), type))
-  std::map<uint32, std::tuple<std::map<uint32, uint32>, uint8> > m_commonData;
+
+  // common data column, materialized for all records when file is opened
+  struct CommonDataColumn
+  {
+    CommonDataColumn() : type(0) {}
+
+    uint8 type;
+    std::vector<uint32> values; // raw value by record index (0 if not defined), empty if column has no value at all
+  };
+
+  std::vector<CommonDataColumn> m_commonData;
 
 };
 
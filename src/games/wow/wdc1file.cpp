@@ -0,0 +1,559 @@
+#include "wdc1file.h"
+
+#include "logger/Logger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  include <emmintrin.h>
+#  define WDC1_USE_SSE2 1
+#else
+#  define WDC1_USE_SSE2 0
+#endif
+
+#include "WoWDatabase.h"
+
+#define WDC1_READ_DEBUG 0
+
+namespace
+{
+  // records decoded column by column in one go
+  const unsigned int UNPACK_BATCH = 256;
+}
+
+WDC1File::WDC1File(const QString & file) :
+DBFile(), CASCFile(file), m_dataEnd(0), m_isSparseTable(false), m_layoutStructure(0)
+{
+}
+
+bool WDC1File::open()
+{
+  if (!CASCFile::open())
+  {
+    LOG_ERROR << "An error occured while trying to read the DBCFile" << fullname();
+    return false;
+  }
+
+  WDC1File::header header;
+  read(&header, sizeof(WDC1File::header)); // File Header
+
+#if WDC1_READ_DEBUG > 0
+  LOG_INFO << "magic" << header.magic[0] << header.magic[1] << header.magic[2] << header.magic[3];
+  LOG_INFO << "record count" << header.record_count;
+  LOG_INFO << "field count" << header.field_count;
+  LOG_INFO << "record size" << header.record_size;
+  LOG_INFO << "string table size" << header.string_table_size;
+  LOG_INFO << "layout hash" << header.layout_hash;
+  LOG_INFO << "min id" << header.min_id;
+  LOG_INFO << "max id" << header.max_id;
+  LOG_INFO << "copy table size" << header.copy_table_size;
+  LOG_INFO << "flags" << header.flags;
+  LOG_INFO << "id index" << header.id_index;
+  LOG_INFO << "id list size" << header.id_list_size;
+  LOG_INFO << "field storage info size" << header.field_storage_info_size;
+  LOG_INFO << "common data size" << header.common_data_size;
+  LOG_INFO << "pallet data size" << header.pallet_data_size;
+  LOG_INFO << "relationship data size" << header.relationship_data_size;
+#endif
+
+  recordSize = header.record_size;
+  recordCount = header.record_count;
+  fieldCount = header.field_count;
+  stringSize = header.string_table_size;
+  m_isSparseTable = ((header.flags & 0x01) != 0);
+
+  std::vector<field_structure> fieldStructure(fieldCount);
+  read(fieldStructure.data(), fieldCount * sizeof(field_structure));
+
+  data = getPointer();
+  m_dataEnd = buffer + getSize();
+
+  if (m_isSparseTable)
+  {
+    // records have variable size, strings being inlined
+    stringTable = 0;
+    stringSize = 0;
+    seek(header.offset_map_offset);
+
+    recordCount = 0;
+
+    for (uint i = 0; i < (header.max_id - header.min_id + 1); i++)
+    {
+      uint32 offset;
+      uint16 length;
+
+      read(&offset, sizeof(offset));
+      read(&length, sizeof(length));
+
+      if ((offset == 0) || (length == 0))
+        continue;
+
+      m_IDs.push_back(header.min_id + i);
+      m_recordOffsets.push_back(buffer + offset);
+      recordCount++;
+    }
+  }
+  else
+  {
+    stringTable = data + recordSize*recordCount;
+
+    m_recordOffsets.reserve(recordCount);
+    for (uint i = 0; i < recordCount; i++)
+      m_recordOffsets.push_back(data + (i*recordSize));
+
+    seekRelative(recordSize*recordCount + stringSize);
+  }
+
+  // ids, when not stored in records
+  if (header.id_list_size > 0)
+  {
+    std::vector<uint32> ids(header.id_list_size / sizeof(uint32));
+    read(ids.data(), ids.size() * sizeof(uint32));
+
+    if (ids.size() == recordCount)
+      m_IDs.swap(ids);
+  }
+
+  // copy table is applied once common and relationship data of source records are known
+  std::vector<copy_table_entry> copyTable(header.copy_table_size / sizeof(copy_table_entry));
+  read(copyTable.data(), copyTable.size() * sizeof(copy_table_entry));
+
+  // fields storage
+  std::vector<field_storage_info> storage(header.field_storage_info_size / sizeof(field_storage_info));
+  read(storage.data(), storage.size() * sizeof(field_storage_info));
+
+  m_fields.resize(fieldCount);
+
+  uint32 palletStart = 0;
+  for (uint i = 0; i < fieldCount; i++)
+  {
+    FieldInfo & field = m_fields[i];
+    field.position = fieldStructure[i].position;
+    field.size = 32 - fieldStructure[i].size;
+    field.palletStart = 0;
+
+    if (i < storage.size())
+    {
+      field.storage = storage[i];
+    }
+    else
+    {
+      memset(&field.storage, 0, sizeof(field.storage));
+      field.storage.offset_bits = field.position * 8;
+      field.storage.size_bits = field.size;
+    }
+
+    if (field.storage.storage_type == STORAGE_BITPACKED_INDEXED || field.storage.storage_type == STORAGE_BITPACKED_INDEXED_ARRAY)
+    {
+      field.palletStart = palletStart;
+      palletStart += field.storage.additional_data_size / sizeof(uint32);
+    }
+
+#if WDC1_READ_DEBUG > 0
+    LOG_INFO << "field" << i << "pos" << field.position << "storage" << field.storage.storage_type
+             << "offset" << field.storage.offset_bits << "size" << field.storage.size_bits << "bits";
+#endif
+  }
+
+  m_pallet.resize(header.pallet_data_size / sizeof(uint32));
+  read(m_pallet.data(), m_pallet.size() * sizeof(uint32));
+
+  // read ids from data
+  if (m_IDs.size() != recordCount)
+  {
+    m_IDs.assign(recordCount, 0);
+
+    if (header.id_index < m_fields.size())
+    {
+      const FieldInfo & idField = m_fields[header.id_index];
+      uint32 idSize = (idField.storage.storage_type == STORAGE_NONE) ? idField.size : idField.storage.value2;
+      unpackBits(m_recordOffsets.data(), recordCount, idField.storage.offset_bits, idSize, m_dataEnd, m_IDs.data());
+    }
+    else
+    {
+      LOG_ERROR << "Invalid id index" << header.id_index << "in" << fullname();
+    }
+  }
+
+  setRecordIds(m_IDs);
+
+  // common data, (id, value) pairs for each field, spread over records through id index
+  std::vector<unsigned char> commonData(header.common_data_size);
+  read(commonData.data(), commonData.size());
+
+  uint32 commonDataOffset = 0;
+  for (FieldInfo & field : m_fields)
+  {
+    if (field.storage.storage_type != STORAGE_COMMON_DATA)
+      continue;
+
+    field.commonData.assign(recordCount, field.storage.value1); // default value
+
+    uint32 end = std::min(commonDataOffset + field.storage.additional_data_size, (uint32)commonData.size());
+    for (uint32 entry = commonDataOffset; entry + 2 * sizeof(uint32) <= end; entry += 2 * sizeof(uint32))
+    {
+      uint32 id, val;
+      memcpy(&id, &commonData[entry], sizeof(id));
+      memcpy(&val, &commonData[entry + sizeof(id)], sizeof(val));
+
+      unsigned int record = findById(id);
+      if (record != npos)
+        field.commonData[record] = val;
+    }
+
+    commonDataOffset += field.storage.additional_data_size;
+  }
+
+  // relationship data, foreign id by record index
+  if (header.relationship_data_size > 0)
+  {
+    uint32 nbEntries, minId, maxId;
+    read(&nbEntries, sizeof(nbEntries));
+    read(&minId, sizeof(minId));
+    read(&maxId, sizeof(maxId));
+
+    m_relationship.assign(recordCount, 0);
+
+    for (uint i = 0; i < nbEntries; i++)
+    {
+      uint32 foreignId, recordIndex;
+      read(&foreignId, sizeof(foreignId));
+      read(&recordIndex, sizeof(recordIndex));
+
+      if (recordIndex < recordCount)
+        m_relationship[recordIndex] = foreignId;
+    }
+  }
+
+  // copied rows alias their source record
+  for (const copy_table_entry & entry : copyTable)
+  {
+    unsigned int source = findById(entry.copiedRowId);
+
+    if (source == npos)
+    {
+      LOG_ERROR << "Copied row" << entry.copiedRowId << "not found in" << fullname();
+      continue;
+    }
+
+    m_IDs.push_back(entry.newRowId);
+    m_recordOffsets.push_back(m_recordOffsets[source]);
+
+    for (FieldInfo & field : m_fields)
+    {
+      if (!field.commonData.empty())
+        field.commonData.push_back(field.commonData[source]);
+    }
+
+    if (!m_relationship.empty())
+      m_relationship.push_back(m_relationship[source]);
+
+    recordCount++;
+  }
+
+  if (!copyTable.empty())
+    setRecordIds(m_IDs);
+
+  return true;
+}
+
+bool WDC1File::close()
+{
+  return CASCFile::close();
+}
+
+uint32 WDC1File::readBits(const unsigned char * record, uint32 bitOffset, uint32 bitSize)
+{
+  quint64 val = 0;
+  memcpy(&val, record + (bitOffset >> 3), ((bitOffset & 7) + bitSize + 7) >> 3);
+  return static_cast<uint32>((val >> (bitOffset & 7)) & ((Q_UINT64_C(1) << bitSize) - 1));
+}
+
+void WDC1File::unpackBits(const unsigned char * const * records, unsigned int count, uint32 bitOffset, uint32 bitSize,
+                          const unsigned char * dataEnd, uint32 * out)
+{
+  unsigned int i = 0;
+
+#if WDC1_USE_SSE2
+  // 4 records at a time : 8 bytes loaded for each, then shifted and masked in 64 bits lanes,
+  // low 32 bits of lanes being packed back together
+  const uint32 byteOffset = bitOffset >> 3;
+  const __m128i shift = _mm_cvtsi32_si128(bitOffset & 7);
+  const int maskValue = static_cast<int>((Q_UINT64_C(1) << bitSize) - 1);
+  const __m128i mask = _mm_set_epi32(0, maskValue, 0, maskValue);
+
+  for (; i + 4 <= count; i += 4)
+  {
+    const unsigned char * r0 = records[i] + byteOffset;
+    const unsigned char * r1 = records[i + 1] + byteOffset;
+    const unsigned char * r2 = records[i + 2] + byteOffset;
+    const unsigned char * r3 = records[i + 3] + byteOffset;
+
+    if (dataEnd - r0 < 8 || dataEnd - r1 < 8 || dataEnd - r2 < 8 || dataEnd - r3 < 8)
+      break;
+
+    __m128i v01 = _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(r0)),
+                                     _mm_loadl_epi64(reinterpret_cast<const __m128i *>(r1)));
+    __m128i v23 = _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(r2)),
+                                     _mm_loadl_epi64(reinterpret_cast<const __m128i *>(r3)));
+
+    v01 = _mm_and_si128(_mm_srl_epi64(v01, shift), mask);
+    v23 = _mm_and_si128(_mm_srl_epi64(v23, shift), mask);
+
+    __m128i packed = _mm_unpacklo_epi64(_mm_shuffle_epi32(v01, _MM_SHUFFLE(3, 1, 2, 0)),
+                                        _mm_shuffle_epi32(v23, _MM_SHUFFLE(3, 1, 2, 0)));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), packed);
+  }
+#else
+  Q_UNUSED(dataEnd);
+#endif
+
+  for (; i < count; i++)
+    out[i] = readBits(records[i], bitOffset, bitSize);
+}
+
+const std::vector<WDC1File::ColumnLayout> & WDC1File::layout(const core::TableStructure * structure) const
+{
+  if (structure == m_layoutStructure)
+    return m_layout;
+
+  m_layout.clear();
+  m_layoutStructure = structure;
+
+  std::map<int, int> fieldIndexes; // position in record -> field index
+  for (uint i = 0; i < m_fields.size(); i++)
+    fieldIndexes[m_fields[i].position] = i;
+
+  for (auto it : structure->fields)
+  {
+    wow::FieldStructure * field = dynamic_cast<wow::FieldStructure *>(it);
+
+    if (!field)
+      continue;
+
+    ColumnLayout c;
+    c.source = ColumnLayout::RECORD_BITS;
+    c.bitOffset = 0;
+    c.bitSize = 0;
+    c.shift = 0;
+    c.field = -1;
+    c.palletIndex = 0;
+    c.palletStride = 1;
+
+    if (field->type == "text")
+      c.type = ColumnLayout::TEXT_VALUE;
+    else if (field->type == "float")
+      c.type = ColumnLayout::FLOAT_VALUE;
+    else if (field->type == "int")
+      c.type = ColumnLayout::INT_VALUE;
+    else
+      c.type = ColumnLayout::UINT_VALUE;
+
+    if (field->isKey)
+    {
+      c.source = ColumnLayout::RECORD_ID;
+      c.type = ColumnLayout::UINT_VALUE;
+      m_layout.push_back(c);
+      continue;
+    }
+
+    if (field->isRelationshipData)
+    {
+      c.source = ColumnLayout::RELATIONSHIP;
+      m_layout.push_back(c);
+      continue;
+    }
+
+    auto index = fieldIndexes.find(field->pos);
+    if (index == fieldIndexes.end())
+    {
+      LOG_ERROR << "No field at position" << field->pos << "in" << fullname() << "- field" << field->name << "read as 0";
+      for (uint i = 0; i < field->arraySize; i++)
+        m_layout.push_back(c);
+      continue;
+    }
+
+    const FieldInfo & info = m_fields[index->second];
+    c.field = index->second;
+
+    for (uint i = 0; i < field->arraySize; i++)
+    {
+      switch (info.storage.storage_type)
+      {
+        case STORAGE_COMMON_DATA:
+          c.source = ColumnLayout::COMMON_DATA;
+          break;
+        case STORAGE_BITPACKED_INDEXED:
+        case STORAGE_BITPACKED_INDEXED_ARRAY:
+          c.source = ColumnLayout::PALLET;
+          c.bitOffset = info.storage.offset_bits;
+          c.bitSize = info.storage.value2;
+          if (info.storage.storage_type == STORAGE_BITPACKED_INDEXED_ARRAY)
+          {
+            c.palletIndex = i;
+            c.palletStride = std::max(info.storage.value3, 1u);
+          }
+          break;
+        case STORAGE_BITPACKED:
+        case STORAGE_BITPACKED_SIGNED:
+          c.bitSize = (field->arraySize > 1) ? info.storage.size_bits / field->arraySize : info.storage.value2;
+          c.bitOffset = info.storage.offset_bits + i*c.bitSize;
+          if (info.storage.storage_type == STORAGE_BITPACKED_SIGNED && c.type == ColumnLayout::INT_VALUE)
+            c.shift = 32 - std::min(c.bitSize, 32u);
+          break;
+        default:
+          c.bitSize = info.size;
+          c.bitOffset = info.storage.offset_bits + i*c.bitSize;
+          if (c.type == ColumnLayout::INT_VALUE)
+            c.shift = 32 - std::min(c.bitSize, 32u);
+          break;
+      }
+
+      // 64 bits values are truncated, as in other formats
+      c.bitSize = std::min(c.bitSize, 32u);
+
+      // 0 bit fields hold no data (and shifting by 32 is undefined) : constant 0
+      if (c.bitSize == 0)
+      {
+        c.shift = 0;
+        if (c.source == ColumnLayout::RECORD_BITS)
+          c.field = -1;
+      }
+
+      m_layout.push_back(c);
+    }
+  }
+
+  return m_layout;
+}
+
+void WDC1File::readColumn(unsigned int first, unsigned int count, const ColumnLayout & column, uint32 * values) const
+{
+  switch (column.source)
+  {
+    case ColumnLayout::RECORD_ID:
+      memcpy(values, &m_IDs[first], count * sizeof(uint32));
+      return;
+    case ColumnLayout::RELATIONSHIP:
+      if (m_relationship.empty())
+        std::fill(values, values + count, 0);
+      else
+        memcpy(values, &m_relationship[first], count * sizeof(uint32));
+      return;
+    default:
+      break;
+  }
+
+  if (column.field < 0)
+  {
+    std::fill(values, values + count, 0);
+    return;
+  }
+
+  const FieldInfo & info = m_fields[column.field];
+
+  if (column.source == ColumnLayout::COMMON_DATA)
+  {
+    memcpy(values, &info.commonData[first], count * sizeof(uint32));
+    return;
+  }
+
+  unpackBits(&m_recordOffsets[first], count, column.bitOffset, column.bitSize, m_dataEnd, values);
+
+  if (column.source == ColumnLayout::PALLET)
+  {
+    // unpacked values are pallet entry indexes
+    size_t palletEnd = std::min(m_pallet.size(), (size_t)(info.palletStart + info.storage.additional_data_size / sizeof(uint32)));
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+      size_t entry = info.palletStart + (size_t)values[i] * column.palletStride + column.palletIndex;
+      values[i] = (entry < palletEnd) ? m_pallet[entry] : 0;
+    }
+  }
+}
+
+void WDC1File::writeValue(const ColumnLayout & column, uint32 value, const unsigned char * record, DBRecordWriter & writer) const
+{
+  switch (column.type)
+  {
+    case ColumnLayout::TEXT_VALUE:
+    {
+      const char * stringPtr = "";
+      if (m_isSparseTable)
+        stringPtr = reinterpret_cast<const char *>(record + (column.bitOffset >> 3));
+      else if (value < stringSize)
+        stringPtr = reinterpret_cast<const char *>(stringTable + value);
+
+      writer.writeText(stringPtr, (int)strlen(stringPtr));
+      break;
+    }
+    case ColumnLayout::FLOAT_VALUE:
+    {
+      float f;
+      memcpy(&f, &value, sizeof(f));
+      writer.writeReal(f);
+      break;
+    }
+    case ColumnLayout::INT_VALUE:
+      writer.writeInt(static_cast<int>(value << column.shift) >> column.shift);
+      break;
+    default:
+      writer.writeInt(value);
+      break;
+  }
+}
+
+void WDC1File::decode(unsigned int begin, unsigned int end, const std::vector<ColumnLayout> & columns, DBRecordWriter & writer, bool notifyRecords) const
+{
+  if (begin >= end)
+    return;
+
+  const unsigned int batchSize = std::min(end - begin, UNPACK_BATCH);
+  std::vector<uint32> values(columns.size() * batchSize);
+
+  for (unsigned int first = begin; first < end; first += batchSize)
+  {
+    unsigned int count = std::min(batchSize, end - first);
+
+    for (size_t c = 0; c < columns.size(); c++)
+      readColumn(first, count, columns[c], &values[c * batchSize]);
+
+    for (unsigned int r = 0; r < count; r++)
+    {
+      if (notifyRecords)
+        writer.beginRecord(first + r);
+
+      for (size_t c = 0; c < columns.size(); c++)
+        writeValue(columns[c], values[c * batchSize + r], m_recordOffsets[first + r], writer);
+    }
+  }
+}
+
+void WDC1File::decodeRange(unsigned int begin, unsigned int end, const core::TableStructure * structure, DBRecordWriter & writer) const
+{
+  decode(begin, end, layout(structure), writer, true);
+}
+
+void WDC1File::writeRecord(unsigned int recordIndex, const core::TableStructure * structure, DBRecordWriter & writer) const
+{
+  decode(recordIndex, recordIndex + 1, layout(structure), writer, false);
+}
+
+std::vector<std::string> WDC1File::get(unsigned int recordIndex, const core::TableStructure * structure) const
+{
+  std::vector<std::string> result;
+
+  DBStringWriter writer(result);
+  decode(recordIndex, recordIndex + 1, layout(structure), writer, false);
+
+  return result;
+}
+
+WDC1File::~WDC1File()
+{
+  close();
+}
@@ -0,0 +1,167 @@
+#ifndef WDC1FILE_H
+#define WDC1FILE_H
+
+#include <QString>
+
+#include "dbfile.h"
+#include "types.h"
+
+#include "CASCFile.h"
+
+#ifdef _WIN32
+#    ifdef BUILDING_WOW_DLL
+#        define _WDC1FILE_API_ __declspec(dllexport)
+#    else
+#        define _WDC1FILE_API_ __declspec(dllimport)
+#    endif
+#else
+#    define _WDC1FILE_API_
+#endif
+
+
+// db2 files where fields are bit packed, possibly as indexes in a pallet, or stored aside as common data
+class _WDC1FILE_API_ WDC1File : public DBFile, public CASCFile
+{
+public:
+
+  struct header
+  {
+    char magic[4];                                               // 'WDC1'
+    uint32 record_count;
+    uint32 field_count;
+    uint32 record_size;
+    uint32 string_table_size;
+    uint32 table_hash;
+    uint32 layout_hash;
+    uint32 min_id;
+    uint32 max_id;
+    uint32 locale;
+    uint32 copy_table_size;
+    uint16 flags;
+    uint16 id_index;
+    uint32 total_field_count;
+    uint32 bitpacked_data_offset;                               // relative position in record where bit packed fields begin
+    uint32 lookup_column_count;
+    uint32 offset_map_offset;                                   // absolute position of offset map, for sparse tables
+    uint32 id_list_size;
+    uint32 field_storage_info_size;
+    uint32 common_data_size;
+    uint32 pallet_data_size;
+    uint32 relationship_data_size;
+  };
+
+  explicit WDC1File(const QString & file);
+  ~WDC1File();
+
+  bool open();
+
+  bool close();
+
+  std::vector<std::string> get(unsigned int recordIndex, const core::TableStructure * structure) const;
+  void writeRecord(unsigned int recordIndex, const core::TableStructure * structure, DBRecordWriter & writer) const;
+  void decodeRange(unsigned int begin, unsigned int end, const core::TableStructure * structure, DBRecordWriter & writer) const;
+
+  // unpack bitSize bits (at most 32) found at bitOffset in each of count records. Up to 8 bytes are loaded
+  // per record, records closer than that from dataEnd are read byte per byte
+  static void unpackBits(const unsigned char * const * records, unsigned int count, uint32 bitOffset, uint32 bitSize,
+                         const unsigned char * dataEnd, uint32 * out);
+
+  // scalar extraction of a single value, as done by unpackBits for each record
+  static uint32 readBits(const unsigned char * record, uint32 bitOffset, uint32 bitSize);
+
+private:
+  enum StorageType
+  {
+    STORAGE_NONE = 0,
+    STORAGE_BITPACKED = 1,
+    STORAGE_COMMON_DATA = 2,
+    STORAGE_BITPACKED_INDEXED = 3,
+    STORAGE_BITPACKED_INDEXED_ARRAY = 4,
+    STORAGE_BITPACKED_SIGNED = 5
+  };
+
+  struct field_structure
+  {
+    int16 size;
+    uint16 position;
+  };
+
+  struct field_storage_info
+  {
+    uint16 offset_bits;
+    uint16 size_bits;                                           // whole field, all array elements included
+    uint32 additional_data_size;                                // size of field values in pallet or common data block
+    uint32 storage_type;
+    uint32 value1;                                              // bitpacking offset, or default value for common data
+    uint32 value2;                                              // bitpacking size (index size for pallet fields)
+    uint32 value3;                                              // flags, or array size for pallet arrays
+  };
+
+  struct copy_table_entry
+  {
+    uint32 newRowId;
+    uint32 copiedRowId;
+  };
+
+  // how a file field is stored, with its pallet and common data resolved
+  struct FieldInfo
+  {
+    uint16 position;
+    uint32 size; // in bits, for unpacked fields
+    field_storage_info storage;
+    uint32 palletStart; // index of first field value in m_pallet
+    std::vector<uint32> commonData; // value by record index, for common data fields
+  };
+
+  // where to get a table column from, array fields being expanded
+  struct ColumnLayout
+  {
+    enum Source
+    {
+      RECORD_ID,
+      RECORD_BITS,
+      PALLET,
+      COMMON_DATA,
+      RELATIONSHIP
+    };
+
+    enum Type
+    {
+      UINT_VALUE,
+      INT_VALUE,
+      FLOAT_VALUE,
+      TEXT_VALUE
+    };
+
+    Source source;
+    Type type;
+    uint32 bitOffset; // in record
+    uint32 bitSize;
+    int shift; // to sign extend int values stored on less than 32 bits
+    int field; // index in m_fields
+    uint32 palletIndex; // position of value in pallet entry, for pallet arrays
+    uint32 palletStride; // pallet values per entry
+  };
+
+  // layout is compiled once per table structure
+  const std::vector<ColumnLayout> & layout(const core::TableStructure * structure) const;
+
+  // decode records column by column, then give them row by row to writer
+  void decode(unsigned int begin, unsigned int end, const std::vector<ColumnLayout> & columns, DBRecordWriter & writer, bool notifyRecords) const;
+  void readColumn(unsigned int first, unsigned int count, const ColumnLayout & column, uint32 * values) const;
+  void writeValue(const ColumnLayout & column, uint32 value, const unsigned char * record, DBRecordWriter & writer) const;
+
+  std::vector<FieldInfo> m_fields;
+  std::vector<uint32> m_pallet;
+  std::vector<uint32> m_IDs;
+  std::vector<uint32> m_relationship; // foreign id by record index, empty if file has none
+  std::vector<const unsigned char *> m_recordOffsets;
+  const unsigned char * m_dataEnd;
+
+  bool m_isSparseTable;
+
+  mutable std::vector<ColumnLayout> m_layout;
+  mutable const core::TableStructure * m_layoutStructure;
+};
+
+#endif
@@ -11,14 +11,6 @@
 
 using namespace std;
 
-void WMO::flipcc(QString & cc)
-{
-  QByteArray ba = cc.toLatin1();
-  char *d = ba.data();
-  std::reverse(d, d + cc.length());
-  cc = QString(d);
-}
-
 WMO::WMO(QString name) : 
   ManagedItem(name),
   maxCoord(), 
@@ -46,19 +38,15 @@ WMO::WMO(QString name) :
 
 	char *texbuf=0;
 
-	while (!f.isEof()) {
-    char buf[5];
-    f.read(buf, 4);
-    buf[4] = 0;
+	core::ChunkDirectory directory;
+	directory.build(f.getBuffer(), 0, f.getSize(), true);
 
-    QString fourcc = QString::fromLatin1(buf);
-    flipcc(fourcc);
+	for (auto & chunk : directory) {
+		unsigned int fourcc = chunk.magic;
+		size = chunk.size;
+		f.seek(chunk.start);
 
-		f.read(&size, 4);
-
-		size_t nextpos = f.getPos() + size;
-
-		if (fourcc == "MOHD") {
+		if (fourcc == core::fourcc("MOHD")) {
 			// Header for the map object. 64 bytes.
 			f.read(&nTextures, 4); // number of materials
 			f.read(&nGroups, 4); // number of WMO groups
@@ -77,14 +65,14 @@ WMO::WMO(QString name) :
 
 			groups = new WMOGroup[nGroups];
 			mat = new WMOMaterial[nTextures];
-		} else if (fourcc == "MOTX") {
+		} else if (fourcc == core::fourcc("MOTX")) {
 			// textures
 			// The beginning of a string is always aligned to a 4Byte Adress. (0, 4, 8, C). 
 			// The end of the string is Zero terminated and filled with zeros until the next aligment. 
 			// Sometimes there also empty aligtments for no (it seems like no) real reason.
 			texbuf = new char[size];
 			f.read(texbuf, size);
-		} else if (fourcc == "MOMT") {
+		} else if (fourcc == core::fourcc("MOMT")) {
 			// materials
 			// Materials used in this map object, 64 bytes per texture (BLP file), nMaterials entries.
 
@@ -109,7 +97,7 @@ WMO::WMO(QString name) :
 //				gLog("\t - %s\n", texpath.c_str());
 
 			}
-		} else if (fourcc == "MOGN") {
+		} else if (fourcc == core::fourcc("MOGN")) {
 			// List of group names for the groups in this map object. There are nGroups entries in this chunk.
 			// A contiguous block of zero-terminated strings. The names are purely informational, 
 			// they aren't used elsewhere (to my knowledge)
@@ -117,21 +105,21 @@ WMO::WMO(QString name) :
 			// _what_ else it could be - tharo
       groupnames = new char[size];
       f.read(groupnames, size);
-		} else if (fourcc == "MOGI") {
+		} else if (fourcc == core::fourcc("MOGI")) {
 			// group info - important information! ^_^
 			// Group information for WMO groups, 32 bytes per group, nGroups entries.
 			for (size_t i=0; i<nGroups; i++) {
 				groups[i].init(this, f, (int)i, groupnames);
 
 			}
-		} else if (fourcc == "MOLT") {
+		} else if (fourcc == core::fourcc("MOLT")) {
 			// Lighting information. 48 bytes per light, nLights entries
 			for (size_t i=0; i<nLights; i++) {
 				WMOLight l;
 				l.init(f);
 				lights.push_back(l);
 			}
-		} else if (fourcc == "MODN") {
+		} else if (fourcc == core::fourcc("MODN")) {
 			// models ...
 			// MMID would be relative offsets for MMDX filenames
 			// List of filenames for M2 (mdx) models that appear in this WMO.
@@ -151,7 +139,7 @@ WMO::WMO(QString name) :
 				}
 				f.seekRelative((int)size);
 			}
-		} else if (fourcc == "MODS") {
+		} else if (fourcc == core::fourcc("MODS")) {
 			// This chunk defines doodad sets.
 			// Doodads in WoW are M2 model files. There are 32 bytes per doodad set, and nSets 
 			// entries. Doodad sets specify several versions of "interior decoration" for a WMO. Like, 
@@ -164,7 +152,7 @@ WMO::WMO(QString name) :
 				f.read(&dds, 32);
 				doodadsets.push_back(dds);
 			}
-		} else if (fourcc == "MODD") {
+		} else if (fourcc == core::fourcc("MODD")) {
 			// Information for doodad instances. 40 bytes per doodad instance, nDoodads entries.
 			// While WMOs and models (M2s) in a map tile are rotated along the axes, doodads within 
 			// a WMO are oriented using quaternions! Hooray for consistency!
@@ -185,7 +173,7 @@ WMO::WMO(QString name) :
 			}
 
 		}
-		else if (fourcc == "MOSB") {
+		else if (fourcc == core::fourcc("MOSB")) {
 			// Skybox. Always 00 00 00 00. Skyboxes are now defined in DBCs (Light.dbc etc.). 
 			// Contained a M2 filename that was used as skybox.
 			if (size>4) {
@@ -204,7 +192,7 @@ WMO::WMO(QString name) :
 
 				}
 		}
-		else if (fourcc == "MOPV") {
+		else if (fourcc == core::fourcc("MOPV")) {
 			// Portal vertices, 4 * 3 * float per portal, nPortals entries.
 			// Portals are (always?) rectangles that specify where doors or entrances are in a WMO. 
 			// They could be used for visibility, but I currently have no idea what relations they have 
@@ -230,7 +218,7 @@ WMO::WMO(QString name) :
 				pvs.push_back(p);
 			}
 		}
-		else if (fourcc == "MOPR") {
+		else if (fourcc == core::fourcc("MOPR")) {
 			// Portal <> group relationship? 2*nPortals entries of 8 bytes.
 			// I think this might specify the two WMO groups that a portal connects.
 			size_t nn = size / 8;
@@ -239,15 +227,15 @@ WMO::WMO(QString name) :
 				prs.push_back(*pr++);
 			}
 		}
-		else if (fourcc == "MOVV") {
+		else if (fourcc == core::fourcc("MOVV")) {
 			// Visible block vertices
 			// Just a list of vertices that corresponds to the visible block list.
 		}
-		else if (fourcc == "MOVB") {
+		else if (fourcc == core::fourcc("MOVB")) {
 			// Visible block list
  			// WMOVB p;
 		}
-		else if (fourcc == "MFOG") {
+		else if (fourcc == core::fourcc("MFOG")) {
 			// Fog information. Made up of blocks of 48 bytes.
 			size_t nfogs = size / 0x30;
 			for (size_t i=0; i<nfogs; i++) {
@@ -256,11 +244,9 @@ WMO::WMO(QString name) :
 				fogs.push_back(fog);
 			}
 		}
-		else if (fourcc == "MFOG") {
+		else if (fourcc == core::fourcc("MFOG")) {
 			// optional, Convex Volume Planes. Contains blocks of floating-point numbers.
 		}
-
-		f.seek(nextpos);
 	}
 
 	f.close();
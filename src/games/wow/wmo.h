@@ -153,8 +153,6 @@ public:
 	void showDoodadSet(int id);
 	void updateModels();
 
-  static void flipcc(QString &);
-
 };
 
 #endif
@@ -486,13 +486,12 @@ bool AnimControl::UpdateCreatureModel(WoWModel *m)
   // see if this model has skins
   LOG_INFO << "Searching skins for" << m->itemName();
 
-  QString query = QString("SELECT Texture1, Texture2, Texture3, ParticleColorID, "
-                          "CreatureDisplayInfo.ID, CreatureGeosetData FROM CreatureDisplayInfo "
-                          "LEFT JOIN CreatureModelData ON CreatureDisplayInfo.ModelID = CreatureModelData.ID "
-                          "WHERE CreatureModelData.FileID = %1")
-                          .arg( m->gamefile->fileDataId());
+  QString query = "SELECT Texture1, Texture2, Texture3, ParticleColorID, "
+                  "CreatureDisplayInfo.ID, CreatureGeosetData FROM CreatureDisplayInfo "
+                  "LEFT JOIN CreatureModelData ON CreatureDisplayInfo.ModelID = CreatureModelData.ID "
+                  "WHERE CreatureModelData.FileID = ?";
 
-  sqlResult r = GAMEDATABASE.sqlQuery(query);
+  sqlResult r = GAMEDATABASE.sqlQuery(query, QVariantList() << m->gamefile->fileDataId());
   PCRList.clear();
   if(r.valid && !r.values.empty())
   {
@@ -519,10 +518,10 @@ bool AnimControl::UpdateCreatureModel(WoWModel *m)
       if (pci)
       {
         grp.particleColInd = pci;
-        QString pciquery = QString("SELECT StartColor1, MidColor1, EndColor1, "
+        QString pciquery = "SELECT StartColor1, MidColor1, EndColor1, "
         "StartColor2, MidColor2, EndColor2, StartColor3, MidColor3, EndColor3 FROM ParticleColor "
-        "WHERE ID = %1;").arg(pci);
-        sqlResult pcir = GAMEDATABASE.sqlQuery(pciquery);
+        "WHERE ID = ?;";
+        sqlResult pcir = GAMEDATABASE.sqlQuery(pciquery, QVariantList() << pci);
         if(pcir.valid && !pcir.empty())
         {
           std::vector<Vec4D> cols;
@@ -636,12 +635,12 @@ bool AnimControl::UpdateItemModel(WoWModel *m)
   LOG_INFO << "Searching skins for" << m->itemName();
 
   // query textures for model1
-  QString query= QString("SELECT TextureID, ParticleColorID, ItemDisplayInfo.ID  FROM ItemDisplayInfo "
-                         "LEFT JOIN TextureFileData ON TextureItemID1 = TextureFileData.ID "
-                         "LEFT JOIN ModelFileData ON ItemDisplayInfo.Model1 = ModelFileData.ID "
-                         "WHERE ModelID = %1").arg(m->gamefile->fileDataId());
+  QString query= "SELECT TextureID, ParticleColorID, ItemDisplayInfo.ID  FROM ItemDisplayInfo "
+                 "LEFT JOIN TextureFileData ON TextureItemID1 = TextureFileData.ID "
+                 "LEFT JOIN ModelFileData ON ItemDisplayInfo.Model1 = ModelFileData.ID "
+                 "WHERE ModelID = ?";
 
-  sqlResult r = GAMEDATABASE.sqlQuery(query);
+  sqlResult r = GAMEDATABASE.sqlQuery(query, QVariantList() << m->gamefile->fileDataId());
 
   if(r.valid && !r.empty())
   {
@@ -659,10 +658,10 @@ bool AnimControl::UpdateItemModel(WoWModel *m)
       if (pci)
       {
         grp.particleColInd = pci;
-        QString pciquery = QString("SELECT StartColor1, MidColor1, EndColor1, "
+        QString pciquery = "SELECT StartColor1, MidColor1, EndColor1, "
         "StartColor2, MidColor2, EndColor2, StartColor3, MidColor3, EndColor3 FROM ParticleColor "
-        "WHERE ID = %1;").arg(pci);
-        sqlResult pcir = GAMEDATABASE.sqlQuery(pciquery);
+        "WHERE ID = ?;";
+        sqlResult pcir = GAMEDATABASE.sqlQuery(pciquery, QVariantList() << pci);
         if(pcir.valid && !pcir.empty())
         {
           std::vector<Vec4D> cols;
@@ -685,12 +684,12 @@ bool AnimControl::UpdateItemModel(WoWModel *m)
   }
   
   // do the same for model2
-  query= QString("SELECT TextureID, ParticleColorID, ItemDisplayInfo.ID  FROM ItemDisplayInfo "
-                 "LEFT JOIN TextureFileData ON TextureItemID2 = TextureFileData.ID "
-                 "LEFT JOIN ModelFileData ON ItemDisplayInfo.Model1 = ModelFileData.ID "
-                 "WHERE ModelID = %1").arg(m->gamefile->fileDataId());
+  query= "SELECT TextureID, ParticleColorID, ItemDisplayInfo.ID  FROM ItemDisplayInfo "
+         "LEFT JOIN TextureFileData ON TextureItemID2 = TextureFileData.ID "
+         "LEFT JOIN ModelFileData ON ItemDisplayInfo.Model1 = ModelFileData.ID "
+         "WHERE ModelID = ?";
 
-  r = GAMEDATABASE.sqlQuery(query);
+  r = GAMEDATABASE.sqlQuery(query, QVariantList() << m->gamefile->fileDataId());
 
   if(r.valid && !r.empty())
   {
@@ -708,10 +707,10 @@ bool AnimControl::UpdateItemModel(WoWModel *m)
       if (pci)
       {
         grp.particleColInd = pci;
-        QString pciquery = QString("SELECT StartColor1, MidColor1, EndColor1, "
+        QString pciquery = "SELECT StartColor1, MidColor1, EndColor1, "
         "StartColor2, MidColor2, EndColor2, StartColor3, MidColor3, EndColor3 FROM ParticleColor "
-        "WHERE ID = %1;").arg(pci);
-        sqlResult pcir = GAMEDATABASE.sqlQuery(pciquery);
+        "WHERE ID = ?;";
+        sqlResult pcir = GAMEDATABASE.sqlQuery(pciquery, QVariantList() << pci);
         if(pcir.valid && !pcir.empty())
         {
           std::vector<Vec4D> cols;
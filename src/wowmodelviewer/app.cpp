@@ -13,6 +13,7 @@
 #include "GlobalSettings.h"
 #include "LogStackWalker.h"
 #include "PluginManager.h"
+#include "QueryProfiler.h"
 #include "resource1.h"
 #include "UserSkins.h"
 #include "util.h"
@@ -311,6 +312,15 @@ int WowModelViewApp::OnExit()
 {
   SaveSettings();
 
+  // game database is never destroyed, log its statistics while exiting
+  if (core::Game::instance().initDone())
+  {
+    GAMEDATABASE.statementCache().logStatistics();
+
+    if (core::QueryProfiler::isEnabled())
+      GAMEDATABASE.queryProfiler().logReport();
+  }
+
   CleanUp();
 
   //_CrtMemDumpAllObjectsSince( NULL );
@@ -367,12 +377,15 @@ void WowModelViewApp::LoadSettings()
   customDirectoryPath = config.value("Settings/CustomDirPath", "").toString().toStdString().c_str();
   customFilesConflictPolicy = config.value("Settings/CustomFilesConflictPolicy", 0).toInt();
   displayItemAndNPCId = config.value("Settings/displayItemAndNPCId", 0).toInt();
+  fileCacheSize = config.value("Settings/FileCacheSize", 256).toInt();
   ssCounter = config.value("Settings/SSCounter", 100).toInt();
   imgFormat = config.value("Settings/DefaultFormat", 1).toInt();
 
   useNewCamera = config.value("Unofficial/UseNewCamera", false).toBool();
   if (config.value("Unofficial/UseDoNotTrailInfo", false).toBool() == true)
     ParticleSystem::useDoNotTrailInfo();
+  if (config.value("Unofficial/ProfileQueries", false).toBool() == true)
+    core::QueryProfiler::enable();
 }
 
 void WowModelViewApp::SaveSettings()
@@ -388,6 +401,7 @@ void WowModelViewApp::SaveSettings()
   config.setValue("Settings/CustomDirPath", customDirectoryPath.c_str());
   config.setValue("Settings/CustomFilesConflictPolicy", customFilesConflictPolicy);
   config.setValue("Settings/displayItemAndNPCId", displayItemAndNPCId);
+  config.setValue("Settings/FileCacheSize", fileCacheSize);
   config.setValue("Settings/SSCounter", ssCounter);
   config.setValue("Settings/DefaultFormat", imgFormat);
 }
@@ -15,6 +15,8 @@ enum ObjectID {
 	ID_FILE_MODEL_INFO,
 	ID_EXPORT_MODEL,
 	ID_FILE_RESETLAYOUT,
+	ID_FILE_REBUILDDB,
+	ID_FILE_QUERYREPORT,
 	ID_FILE_EXIT,
   ID_STATUS_REFRESH_TIMER,
 
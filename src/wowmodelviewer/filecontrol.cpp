@@ -7,6 +7,7 @@
 #include <QImage>
 
 #include "CASCFile.h"
+#include "FileNameIndex.h"
 #include "Game.h"
 #include "globalvars.h"
 #include "logger/Logger.h"
@@ -51,6 +52,7 @@ All suffixs in MPQ:
 */
 static QString content;
 static QString filterString;
+static core::FileNameIndex::Result searchResult; // kept so that next search only narrows it while text grows
 static QString filterStrings[] = {"m2", "wmo", "adt", "wav", "ogg", "mp3",
 	"blp", "bls", "dbc", "db2", "lua", "xml", "skin"};
 static wxString chos[] = {wxT("Models (*.m2)"), wxT("WMOs (*.wmo)"), wxT("ADTs (*.adt)"), wxT("WAVs (*.wav)"), wxT("OGGs (*.ogg)"), wxT("MP3s (*.mp3)"), 
@@ -127,13 +129,13 @@ void FileControl::Init(ModelViewer* mv)
 	// Gets the list of files that meet the filter criteria
 	// and puts them into an array to be processed into our file tree
 	content = QString(txtContent->GetValue().c_str()).toLower().trimmed();
-	filterString = "^.*"+ content +".*\\." + filterStrings[filterMode];
-	std::set<GameFile *> files;
-	GAMEDIRECTORY.getFilteredFiles(files, filterString);
+	filterString = filterStrings[filterMode];
+	std::vector<GameFile *> files;
+	GAMEDIRECTORY.searchFiles(files, searchResult, content, filterString);
 
 	LOG_INFO << "Initializing File Controls - Filtering done - files found" << files.size();
 	TreeStackItem root;
-	for (std::set<GameFile *>::iterator it = files.begin(); it != files.end(); ++it) {
+	for (std::vector<GameFile *>::const_iterator it = files.begin(); it != files.end(); ++it) {
 	  QString name = (*it)->fullname();
 	  beautifyFileName(name);
 
@@ -349,33 +349,29 @@ MapTile::MapTile(wxString filename): nWMO(0), nMDX(0), topnode(0,0,16)
 	}
 
 	name = filename;
-	char fourcc[5];
 	uint32 size;
 
 	size_t mcnk_offsets[CHUNKS_IN_TILE*CHUNKS_IN_TILE], mcnk_sizes[CHUNKS_IN_TILE*CHUNKS_IN_TILE];
 	memset(mcnk_offsets, 0, sizeof(mcnk_offsets));
 	memset(mcnk_sizes, 0, sizeof(mcnk_sizes));
 
-	while (!f.isEof()) {
-		memset(fourcc, 0, 4);
-		size = 0;
-		f.read(fourcc,4);
-		f.read(&size, 4);
+	core::ChunkDirectory directory;
+	directory.build(f.getBuffer(), 0, f.getSize(), true);
 
-		flipcc(fourcc);
-		fourcc[4] = 0;
+	for (auto & chunk : directory) {
+		unsigned int fourcc = chunk.magic;
+		size = chunk.size;
 
 		if (size == 0)
 			continue;
 
-		// remember the next absolute pos
-		size_t nextpos = f.getPos() + size;
+		f.seek(chunk.start);
 
-		if (strncmp(fourcc, "MVER", 4) == 0) {
+		if (fourcc == core::fourcc("MVER")) {
 		}
-		else if (strncmp(fourcc, "MHDR", 4) == 0) {
+		else if (fourcc == core::fourcc("MHDR")) {
 		}
-		else if (strncmp(fourcc,"MCIN",4)==0) {
+		else if (fourcc == core::fourcc("MCIN")) {
 
 			//Index for MCNK chunks. Contains 256 records of 16 bytes, which have the following format:
 			//struct SMChunkInfo // 03-29-2005 By ObscuR
@@ -397,7 +393,7 @@ MapTile::MapTile(wxString filename): nWMO(0), nMDX(0), topnode(0,0,16)
 			} else
 				LOG_ERROR << "wrong MCIN chunk" << size;
 		}
-		else if (strncmp(fourcc,"MTEX",4)==0) {
+		else if (fourcc == core::fourcc("MTEX")) {
 
 		//	List of textures used by the terrain in this map tile.
 		//	A contiguous block of zero-terminated strings, that are complete filenames with paths. The textures will later be identified by their position in this list.
@@ -425,7 +421,7 @@ MapTile::MapTile(wxString filename): nWMO(0), nMDX(0), topnode(0,0,16)
 			}
 			delete[] buf;
 		}
-		else if (strncmp(fourcc,"MMDX",4)==0) {
+		else if (fourcc == core::fourcc("MMDX")) {
 		//	List of filenames for M2 models that appear in this map tile. A contiguous block of zero-terminated strings.
 			// models ...
 			// MMID would be relative offsets for MMDX filenames
@@ -446,13 +442,13 @@ MapTile::MapTile(wxString filename): nWMO(0), nMDX(0), topnode(0,0,16)
 //			}
 //			delete[] buf;
 		}
-		else if (strncmp(fourcc,"MMID",4)==0) {
+		else if (fourcc == core::fourcc("MMID")) {
 
 //			Lists the relative offsets of string beginnings in the above MMDX chunk. One 32-bit integer per offset.
 //			This will be referenced in the offsets in MDDF --Cromon 16:38, 28 August 2009 (CEST)
 
 		}
-		else if (strncmp(fourcc,"MWMO",4)==0) {
+		else if (fourcc == core::fourcc("MWMO")) {
 
 //			List of filenames for WMOs (world map objects) that appear in this map tile. A contiguous block of zero-terminated strings.
 
@@ -475,13 +471,13 @@ MapTile::MapTile(wxString filename): nWMO(0), nMDX(0), topnode(0,0,16)
 //			delete[] buf;
 
 		}
-		else if (strncmp(fourcc,"MWID",4)==0) {
+		else if (fourcc == core::fourcc("MWID")) {
 
 //			Lists the relative offsets of string beginnings in the above MWMO chunk. One 32-bit integer per offset.
 //			Again referenced in MODF
 
 		}
-		else if (strncmp(fourcc,"MDDF",4)==0) {
+		else if (fourcc == core::fourcc("MDDF")) {
 
 //			Placement information for doodads (M2 models). 36 bytes per model instance.
 //			Offset 	Type 		Description
@@ -532,7 +528,7 @@ MapTile::MapTile(wxString filename): nWMO(0), nMDX(0), topnode(0,0,16)
 //			}
 
 		}
-		else if (strncmp(fourcc,"MODF",4)==0) {
+		else if (fourcc == core::fourcc("MODF")) {
 
 //			Placement information for WMOs. 64 bytes per WMO instance.
 //			Offset 	Type 		Description
@@ -585,7 +581,7 @@ MapTile::MapTile(wxString filename): nWMO(0), nMDX(0), topnode(0,0,16)
 //			}
 
 		}
-		else if (strncmp(fourcc,"MH2O",4)==0) {
+		else if (fourcc == core::fourcc("MH2O")) {
 			unsigned char *abuf = f.getPointer();
 			struct WaterTile *mh2oh;
 			struct WaterLayer *mh2oi;
@@ -704,10 +700,10 @@ MapTile::MapTile(wxString filename): nWMO(0), nMDX(0), topnode(0,0,16)
 				//Water.push_back( waterTile );
 			}
 		}
-		else if(strncmp(fourcc, "MCNK", 4) == 0) {
+		else if(fourcc == core::fourcc("MCNK")) {
 			// MCNK data will be processed separately ^_^
 		}
-		else if(strncmp(fourcc, "MFBO", 4) == 0) {
+		else if(fourcc == core::fourcc("MFBO")) {
 
 //			A bounding box for flying.
 //			This chunk is a "box" defining, where you can fly and where you can't. It also defines the height at which one you will fall into nowhere while your camera remains at the same position. Its actually two planes with 3*3 coordinates per plane.
@@ -722,7 +718,7 @@ MapTile::MapTile(wxString filename): nWMO(0), nMDX(0), topnode(0,0,16)
 //			};
 
 		}
-		else if(strncmp(fourcc, "MTFX", 4) == 0) {
+		else if(fourcc == core::fourcc("MTFX")) {
 
 //			This chunk is an array of integers that are 1 or 0. 1 means that the texture at the same position in the MTEX array has to be handled differentely. The size of this chunk is always the same as there are entries in the MTEX chunk.
 //			Simple as it is:
@@ -734,10 +730,8 @@ MapTile::MapTile(wxString filename): nWMO(0), nMDX(0), topnode(0,0,16)
 //
 		}
 		else {
-			LOG_ERROR << "No implement tile chunk" << fourcc << "[" << size << "]";
+			LOG_ERROR << "No implement tile chunk" << core::fourccName(fourcc).c_str() << "[" << size << "]";
 		}
-
-		f.seek((int)nextpos);
 	}
 
 	// read individual map chunks
@@ -986,35 +980,63 @@ void MapChunk::initTextures(wxString basename, int first, int last)
 
 static unsigned char blendbuf[64*64*4]; // make unstable when new/delete, just make it global
 static unsigned char amap[64*64];
+
+// ADT chunk names are stored byte swapped
+static unsigned int adtMagic(const unsigned char * p)
+{
+	return (unsigned int)p[3] | ((unsigned int)p[2] << 8) | ((unsigned int)p[1] << 16) | ((unsigned int)p[0] << 24);
+}
+
+// add the sub chunk whose header is at ofs from the MCNK start
+// headerSize, when given, replaces the chunk size field (it includes the 8 bytes chunk header)
+static void addSubChunk(core::ChunkDirectory & directory, const unsigned char * buffer, size_t mcnk_pos, size_t lastpos, uint32 ofs, uint32 headerSize = 0)
+{
+	if (ofs == 0 || mcnk_pos + ofs + 8 > lastpos)
+		return;
+
+	const unsigned char * p = buffer + mcnk_pos + ofs;
+	uint32 size;
+	memcpy(&size, p + 4, 4);
+	if (headerSize != 0)
+		size = (headerSize > 8) ? headerSize - 8 : 0;
+
+	size_t start = mcnk_pos + ofs + 8;
+	if (size > lastpos - start)
+		size = (uint32)(lastpos - start);
+
+	if (size != 0)
+		directory.add(adtMagic(p), (unsigned int)start, size);
+}
+
 void MapChunk::init(MapTile* mt, GameFile &f, bool bigAlpha)
 {
 	//Vec3D tn[mapbufsize], tv[mapbufsize];
 	
 	maptile = mt;
 
-	char fcc[5];
-	uint32 size;
-
+	const unsigned char * buffer = f.getBuffer();
 	size_t mcnk_pos = f.getPos();
+	unsigned int magic = 0;
+	uint32 size = 0;
 
-	f.read(fcc,4); // MCNK
-	f.read(&size, 4);
-//	flipcc(fcc); // in former mpq.h
-	fcc[4] = 0;
+	if (buffer && mcnk_pos + 8 + 0x80 <= f.getSize()) {
+		magic = adtMagic(buffer + mcnk_pos);
+		memcpy(&size, buffer + mcnk_pos + 4, 4);
+	}
 
-	if (strncmp(fcc, "MCNK", 4)!=0 || size == 0) {
-		LOG_ERROR << "mcnk main chunk" << fcc << "[" << size << "].";
+	if (magic != core::fourcc("MCNK") || size < 0x80 || size > f.getSize() - mcnk_pos - 8) {
+		LOG_ERROR << "mcnk main chunk" << core::fourccName(magic).c_str() << "[" << size << "].";
 		return;
 	}
 
 	// okay here we go ^_^
 	mBigAlpha=bigAlpha;
 	
-	size_t lastpos = f.getPos() + size;
+	size_t lastpos = mcnk_pos + 8 + size;
 
 	//char header[0x80];
 	//MapChunkHeader header;
-	f.read(&header, 0x80);
+	memcpy(&header, buffer + mcnk_pos + 8, 0x80);
 
 	areaID = header.areaid;
 
@@ -1085,64 +1107,29 @@ void MapChunk::init(MapTile* mt, GameFile &f, bool bigAlpha)
 		memset(blendbuf, 0, 64*64*4);
 	}
 
-	while (f.getPos() < lastpos) {
-		memset(fcc, 0, 4);
-		size = 0;
-		f.read(fcc,4);
-		f.read(&size, 4);
-//		flipcc(fcc); // in former mpq.h
-		fcc[4] = 0;
-
-		//gLog("fcc: %s, size: %d, pos: %d, size: %d.\n", fcc, size, f.getPos(), f.getSize());
-
-		if (size == 0) {
-			// MCAL always has wrong size....
-			if (strncmp(fcc, "MCAL", 4) == 0 && (size+8) != header.sizeAlpha) {
-				f.read(fcc,4);
-//				flipcc(fcc); // in former mpq.h
-				fcc[4] = 0;
-				size_t nextpos;
-				if (strncmp(fcc, "MCLQ", 4) == 0) {
-					nextpos = f.getPos() + size;
-				} else {
-					nextpos = mcnk_pos+header.ofsAlpha+header.sizeAlpha;
-				}
-				f.seek((int)nextpos);
-				//gLog("mcnk %d, pos %d, size %d, ofsAlpha %d, sizeAlpha %d, nextpos %d\n", mcnk_pos, f.getPos(), size, header.ofsAlpha, header.sizeAlpha, nextpos);
-			}
-			// MCLQ sometimes has wrong size, like StratholmeCOT
-			if (strncmp(fcc, "MCLQ", 4) == 0) // nothing behind MCLQ, just break;
-				break;
-			if (strncmp(fcc, "MCLQ", 4) == 0 && (size+8) != header.sizeLiquid) {
-				f.read(fcc,4);
-//				flipcc(fcc); // in former mpq.h
-				fcc[4] = 0;
-				size_t nextpos;
-				if (strncmp(fcc, "MCSE", 4) == 0) {
-					nextpos = f.getPos() + size;
-				} else {
-					nextpos = mcnk_pos+header.ofsSndEmitters;
-					f.seek((int)nextpos);
-					f.read(fcc, 4);
-//					flipcc(fcc); // in former mpq.h
-					fcc[4] = 0;
-					if (strncmp(fcc, "MCSE", 4) != 0)
-						break; // nothing behind MCLQ, just break;
-				}
-				f.seek((int)nextpos);
-				//gLog("mcnk %d, pos %d, size %d, ofsAlpha %d, sizeAlpha %d, nextpos %d\n", mcnk_pos, f.getPos(), size, header.ofsAlpha, header.sizeAlpha, nextpos);
-			}
-			continue;
-		}
-
-		size_t nextpos = f.getPos() + size;
-
-		if (fcc[0] != 'M' || f.getPos() > f.getSize()) {
-			LOG_ERROR << "mcnk chunk initial error, fcc:" << fcc << ", size:" << size << ", pos: " << f.getPos() << ", size:" << f.getSize();
-			break;
-		}
-
-		if (strncmp(fcc, "MCVT", 4) == 0) {
+	// sub chunks are located through the MCNK header offsets rather than by walking their size
+	// fields: MCNR is followed by padding, and MCAL / MCLQ sizes are wrong in a lot of files
+	// (the header ones are right). Order matters, MCLY must be read before MCAL.
+	core::ChunkDirectory directory;
+	addSubChunk(directory, buffer, mcnk_pos, lastpos, header.ofsHeight);
+	addSubChunk(directory, buffer, mcnk_pos, lastpos, header.ofsNormal);
+	addSubChunk(directory, buffer, mcnk_pos, lastpos, header.ofsLayer);
+	addSubChunk(directory, buffer, mcnk_pos, lastpos, header.ofsRefs);
+	addSubChunk(directory, buffer, mcnk_pos, lastpos, header.ofsAlpha, header.sizeAlpha);
+	addSubChunk(directory, buffer, mcnk_pos, lastpos, header.ofsShadow);
+	if (header.sizeLiquid > 8)
+		addSubChunk(directory, buffer, mcnk_pos, lastpos, header.ofsLiquid, header.sizeLiquid);
+	if (header.nSndEmitters > 0)
+		addSubChunk(directory, buffer, mcnk_pos, lastpos, header.ofsSndEmitters);
+	if (chunkflags & 0x40)
+		addSubChunk(directory, buffer, mcnk_pos, lastpos, header.textureId);
+
+	for (auto & chunk : directory) {
+		magic = chunk.magic;
+		size = chunk.size;
+		f.seek(chunk.start);
+
+		if (magic == core::fourcc("MCVT")) {
 			/*
 			These are the actual height values for the 9x9+8x8 vertices. 145 floats in the following order/arrangement:.
 			1    2	3	 4	  5    6	7	 8	  9
@@ -1165,13 +1152,15 @@ void MapChunk::init(MapTile* mt, GameFile &f, bool bigAlpha)
 			The inner 8 vertices are only rendered in WoW when its using the up-close LoD. Otherwise, it only renders the outer 9. Nonsense? If I only change one of these it looks like: [1].
 			Ok, after a further look into it, WoW uses Squares out of 4 of the Outer(called NoLoD)-Vertices with one of the Inner(called LoD)-Vertices in the Center:
 			*/
+			core::ChunkView<float> heights(buffer + chunk.start, size);
 			Vec3D *ttv = tv;
+			size_t k = 0;
 
 			// vertices
 			for (int j=0; j<17; j++) {
 				for (int i=0; i<((j%2)?8:9); i++) {
-					float h,xpos,zpos;
-					f.read(&h,4);
+					float h = 0.0f,xpos,zpos;
+					heights.get(k++, h);
 					xpos = i * UNITSIZE;
 					zpos = j * 0.5f * UNITSIZE;
 					if (j%2) {
@@ -1191,7 +1180,7 @@ void MapChunk::init(MapTile* mt, GameFile &f, bool bigAlpha)
 			r = (vmax - vmin).length() * 0.5f;
 
 		}
-		else if (strncmp(fcc, "MCNR", 4) == 0) {
+		else if (magic == core::fourcc("MCNR")) {
 			/*
 			MCNR sub-chunk
 			Normal vectors for each vertex, encoded as 3 signed bytes per normal, in the same order as specified above.
@@ -1199,20 +1188,20 @@ void MapChunk::init(MapTile* mt, GameFile &f, bool bigAlpha)
 			Normals are stored in X,Z,Y order, with 127 being 1.0 and -127 being -1.0. The vectors are normalized.
 			--Log 09:23, 28 May 2006 (EEST) Maybe the extra data are "edge flag" bitmaps that are used only by the client for smoothing normals around adjustment triangles ? I didn't check it, just a hint.
 			*/
-			nextpos = f.getPos() + 0x1C0; // size fix
 			// normal vectors
-			char nor[3];
+			core::ChunkView<char> nors(buffer + chunk.start, size);
 			Vec3D *ttn = tn;
+			size_t k = 0;
 			for (int j=0; j<17; j++) {
-				for (int i=0; i<((j%2)?8:9); i++) {
-					f.read(nor,3);
+				for (int i=0; i<((j%2)?8:9) && k+3 <= nors.size(); i++, k+=3) {
+					const char * nor = nors.data() + k;
 					// order Z,X,Y ?
 					//*ttn++ = Vec3D((float)nor[0]/127.0f, (float)nor[2]/127.0f, (float)nor[1]/127.0f);
 					*ttn++ = Vec3D(-(float)nor[1]/127.0f, (float)nor[2]/127.0f, -(float)nor[0]/127.0f);
 				}
 			}
 		}
-		else if (strncmp(fcc, "MCLY", 4) == 0) {
+		else if (magic == core::fourcc("MCLY")) {
 			/*
 			MCLY sub-chunk
 			Complete and right as of 19-AUG-09 (3.0.9 or higher)
@@ -1244,10 +1233,11 @@ void MapChunk::init(MapTile* mt, GameFile &f, bool bigAlpha)
 			0x400	 Shiny! This layer adds reflection of the skybox in the texture. You should add a MTFX chunk.
 			*/
 			// texture info
-			nTextures = size / 16;
+			core::ChunkView<MCLY> layers(buffer + chunk.start, size);
+			nTextures = std::min(layers.size(), (size_t)4);
 			//gLog("=\n");
 			for (size_t i=0; i<nTextures; i++) {
-				f.read(&mcly[i], sizeof(struct MCLY));
+				mcly[i] = layers[i];
 
 				if (mcly[i].flags & 0x80) {
 					animated[i] = mcly[i].flags;
@@ -1258,13 +1248,13 @@ void MapChunk::init(MapTile* mt, GameFile &f, bool bigAlpha)
 				textures[i] = TEXTUREMANAGER.get(mt->textures[mcly[i].textureId].c_str());
 			}
 		}
-		else if (strncmp(fcc, "MCRF", 4) == 0) {
+		else if (magic == core::fourcc("MCRF")) {
 			/*
 			A list of with MCNK.nDoodadRefs + MCNK.nMapObjRefs indices into the file's MDDF and MODF chunks, saying which MCNK subchunk those particular doodads and objects are drawn within. This MCRF list contains duplicates for map doodads that overlap areas.
 			As both, WMOs and M2s are referenced here, they get doodad indices first, then WMOs. If you have a doodad and a WMO in the ADT as well as the MCNK, you will have a {0,0} in MCRF with nDoodadRefs and MCNK.nMapObjRefs being 1.
 			*/
 		}
-		else if (strncmp(fcc, "MCAL", 4) == 0) {
+		else if (magic == core::fourcc("MCAL")) {
 			/*
 			Alpha maps for additional texture layers. For every layer, a 32x64 array of alpha values. Can be used as a secondary texture with the modulation op to control the blending of the texture layers. For video cards with 2 texture units, this requires one pass per layer. (For 4 or more texture units, maybe this could be done faster using register combiners? Pixel shaders maybe?)
 			The size field of this chunk might be wrong for map chunks with zero texture layers. There are a couple of these in some of the development maps.
@@ -1418,19 +1408,16 @@ void MapChunk::init(MapTile* mt, GameFile &f, bool bigAlpha)
 				}
 
 			}
-			// some MCAL chunks have incorrect sizes! :(
-			if ((size+8) != header.sizeAlpha) {
-				// continue;
-				nextpos = mcnk_pos+header.ofsAlpha+header.sizeAlpha;
-				//gLog("mcnk %d, pos %d, size %d, ofsAlpha %d, sizeAlpha %d, nextpos %d\n", mcnk_pos, f.getPos(), size, header.ofsAlpha, header.sizeAlpha, nextpos);
-			}
 		}
-		else if (strncmp(fcc,"MCSH", 4) == 0) {
+		else if (magic == core::fourcc("MCSH")) {
 			// shadow map 64 x 64
-			unsigned char sbuf[64*64], *p, c[8];
+			core::ChunkView<unsigned char> shadowmap(buffer + chunk.start, size);
+			if (shadowmap.size() < 64*8)
+				continue;
+			unsigned char sbuf[64*64], *p;
 			p = sbuf;
 			for (ssize_t j=0; j<64; j++) {
-				f.read(c,8);
+				const unsigned char * c = shadowmap.data() + j*8;
 				for (size_t i=0; i<8; i++) {
 					for (ssize_t b=0x01; b!=0x100; b<<=1) {
 						*p++ = (c[i] & b) ? 85 : 0;
@@ -1451,7 +1438,7 @@ void MapChunk::init(MapTile* mt, GameFile &f, bool bigAlpha)
 				}
 			}
 		}
-		else if (strncmp(fcc,"MCLQ", 4) == 0) {
+		else if (magic == core::fourcc("MCLQ")) {
 			/*
 			Water levels for this map chunk. This chunk is old and not really used anymore. Still, there is backwards compatibility in the client as old ADTs are not updated as it would be much data to patch it. I guess, it will be done in some expansion. You can fully use this chunk, even to have multiple water. You can have a lot of stacked water with this and the MH2O one. I advise you to implement the MH2O one as its better if you want to write a editor for ADT files.
 			The size of the chunk is in the mapchunk header. The type of liquid is given in the mapchunk flags, also in the header.
@@ -1486,9 +1473,8 @@ void MapChunk::init(MapTile* mt, GameFile &f, bool bigAlpha)
 			if (flags & 32) lq.append(" slime?");
 			gLog("LQ%s (base:%f)\n", lq.c_str(), waterlevel);
 			*/
-			break; // nothing behind MCLQ, just break;
 		}
-		else if (strncmp(fcc,"MCSE", 4) == 0) {
+		else if (magic == core::fourcc("MCSE")) {
 			/*
 			Sound emitters.
 			This seems to be a bit different to that structure, ObscuR posted back then. From what I can see, WoW takes only 0x1C bytes per entry. Quite a big difference. This change might have happened, when they introduced the SoundEntriesAdvanced.dbc.
@@ -1504,7 +1490,7 @@ void MapChunk::init(MapTile* mt, GameFile &f, bool bigAlpha)
 			};
 			*/
 		}
-		else if (!strncmp(fcc, "MCCV", 4)) {
+		else if (magic == core::fourcc("MCCV")) {
 			/*
 			New Subchunk found in Northrend-adts(and only there as far as I see). Size seems to be always 0x244. Offset seems to be at 0x74 in the MCNK-header.
 			--Tigurius:Found in WotLK-Beta 3.0.1
@@ -1522,9 +1508,8 @@ void MapChunk::init(MapTile* mt, GameFile &f, bool bigAlpha)
 			//gLog("No implement mcnk subchunk %s [%d].\n", fcc, size);
 		}
 		else {
-			LOG_ERROR << "No implement mcnk subchunk" << fcc << "[" << size << "]";
+			LOG_ERROR << "No implement mcnk subchunk" << core::fourccName(magic).c_str() << "[" << size << "]";
 		}
-		f.seek((int)nextpos);
 	}
 
 	// create vertex buffers
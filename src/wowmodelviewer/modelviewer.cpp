@@ -27,6 +27,7 @@
 #include "ModelRenderPass.h"
 #include "ModelTransparency.h"
 #include "PluginManager.h"
+#include "QueryProfiler.h"
 #include "RaceInfos.h"
 #include "TextureAnim.h"
 #include "SettingsControl.h"
@@ -70,6 +71,8 @@ EVT_MENU(ID_FILE_EXPORTAVI, ModelViewer::OnSave)
 EVT_MENU(ID_FILE_MODEL_INFO, ModelViewer::OnExportOther)
 //--
 EVT_MENU(ID_FILE_RESETLAYOUT, ModelViewer::OnToggleCommand)
+EVT_MENU(ID_FILE_REBUILDDB, ModelViewer::OnToggleCommand)
+EVT_MENU(ID_FILE_QUERYREPORT, ModelViewer::OnToggleCommand)
 // --
 EVT_MENU(ID_FILE_EXIT, ModelViewer::OnExit)
 
@@ -349,6 +352,8 @@ void ModelViewer::InitMenu()
 
   fileMenu->AppendSeparator();
   fileMenu->Append(ID_FILE_RESETLAYOUT, _("Reset Layout"));
+  fileMenu->Append(ID_FILE_REBUILDDB, _("Rebuild Database on Next Start"));
+  fileMenu->Append(ID_FILE_QUERYREPORT, _("Save Query Profile Report..."));
   fileMenu->AppendSeparator();
   fileMenu->Append(ID_FILE_EXIT, _("E&xit\tCTRL+X"));
 
@@ -632,17 +637,18 @@ void ModelViewer::InitDatabase()
   initDB = true;
 
   {
-    sqlResult npc = GAMEDATABASE.sqlQuery("SELECT ID, DisplayID1, CreatureTypeID, Name From Creature;");
+    core::SqlQuery npc = GAMEDATABASE.prepare("SELECT ID, DisplayID1, CreatureTypeID, Name From Creature;");
 
-    if (npc.valid && !npc.empty())
+    while (npc.next())
     {
-      LOG_INFO << "Found" << npc.values.size() << "NPCs";
-      for (int i = 0, imax = npc.values.size(); i < imax; i++)
-      {
-        NPCRecord rec(npc.values[i]);
-        if (rec.model != 0)
-          npcs.push_back(rec);
-      }
+      NPCRecord rec(npc);
+      if (rec.model != 0)
+        npcs.push_back(rec);
+    }
+
+    if (!npc.hasError() && !npcs.empty())
+    {
+      LOG_INFO << "Found" << npcs.size() << "NPCs";
     }
     else
     {
@@ -654,16 +660,18 @@ void ModelViewer::InitDatabase()
   }
   
   {
-    sqlResult item = GAMEDATABASE.sqlQuery("SELECT Item.ID, ItemSparse.Name, Item.Type, Item.Class, Item.SubClass, Item.Sheath, ItemSparse.Quality FROM Item LEFT JOIN ItemSparse ON Item.ID = ItemSparse.ID WHERE Item.Type !=0 AND ItemSparse.Name != \"\"");
+    core::SqlQuery item = GAMEDATABASE.prepare("SELECT Item.ID, ItemSparse.Name, Item.Type, Item.Class, Item.SubClass, Item.Sheath, ItemSparse.Quality FROM Item LEFT JOIN ItemSparse ON Item.ID = ItemSparse.ID WHERE Item.Type !=0 AND ItemSparse.Name != \"\"");
 
-    if (item.valid && !item.empty())
+    unsigned int nbItems = 0;
+    while (item.next())
     {
-      LOG_INFO << "Found" << item.values.size() << "items";
-      for (int i = 0, imax = item.values.size(); i < imax; i++)
-      {
-        ItemRecord rec(item.values[i]);
-        items.items.push_back(rec);
-      }
+      items.items.push_back(ItemRecord(item));
+      nbItems++;
+    }
+
+    if (!item.hasError() && nbItems != 0)
+    {
+      LOG_INFO << "Found" << nbItems << "items";
     }
     else
     {
@@ -1089,14 +1097,14 @@ void ModelViewer::LoadNPC(unsigned int modelid)
   isWMO = false;
 
 
-  QString query = QString("SELECT CreatureModelData.FileID, CreatureDisplayInfo.Texture1, "
-                          "CreatureDisplayInfo.Texture2, CreatureDisplayInfo.Texture3, "
-                          "CreatureDisplayInfo.ExtendedDisplayInfoID, CreatureDisplayInfo.ID FROM Creature "
-                          "LEFT JOIN CreatureDisplayInfo ON Creature.DisplayID1 = CreatureDisplayInfo.ID "
-                          "LEFT JOIN CreatureModelData ON CreatureDisplayInfo.modelID = CreatureModelData.ID "
-                          "WHERE Creature.ID = %1;").arg(modelid);
+  QString query = "SELECT CreatureModelData.FileID, CreatureDisplayInfo.Texture1, "
+                  "CreatureDisplayInfo.Texture2, CreatureDisplayInfo.Texture3, "
+                  "CreatureDisplayInfo.ExtendedDisplayInfoID, CreatureDisplayInfo.ID FROM Creature "
+                  "LEFT JOIN CreatureDisplayInfo ON Creature.DisplayID1 = CreatureDisplayInfo.ID "
+                  "LEFT JOIN CreatureModelData ON CreatureDisplayInfo.modelID = CreatureModelData.ID "
+                  "WHERE Creature.ID = ?;";
 
-  sqlResult r = GAMEDATABASE.sqlQuery(query);
+  sqlResult r = GAMEDATABASE.sqlQuery(query, QVariantList() << modelid);
 
   if (r.valid && !r.empty())
   {
@@ -1113,9 +1121,9 @@ void ModelViewer::LoadNPC(unsigned int modelid)
     {
       LoadModel(GAMEDIRECTORY.getFile(RaceInfos::getHDModelForFileID(r.values[0][0].toInt())));
 
-      query = QString("SELECT Skin, Face, HairStyle, HairColor, FacialHair FROM CreatureDisplayInfoExtra WHERE ID = %1").arg(extraId);
+      query = "SELECT Skin, Face, HairStyle, HairColor, FacialHair FROM CreatureDisplayInfoExtra WHERE ID = ?";
 
-      r = GAMEDATABASE.sqlQuery(query);
+      r = GAMEDATABASE.sqlQuery(query, QVariantList() << extraId);
 
       if (r.valid && !r.empty())
       {
@@ -1126,9 +1134,9 @@ void ModelViewer::LoadNPC(unsigned int modelid)
         g_charControl->model->cd.set(CharDetails::ADDITIONAL_FACIAL_CUSTOMIZATION, r.values[0][4].toInt());
       }
 
-      query = QString("SELECT ItemDisplayInfoID, ItemType FROM NpcModelItemSlotDisplayInfo WHERE CreatureDisplayInfoExtraID = %1").arg(extraId);
+      query = "SELECT ItemDisplayInfoID, ItemType FROM NpcModelItemSlotDisplayInfo WHERE CreatureDisplayInfoExtraID = ?";
 
-      r = GAMEDATABASE.sqlQuery(query);
+      r = GAMEDATABASE.sqlQuery(query, QVariantList() << extraId);
 
       if (r.valid && !r.empty())
       {
@@ -1168,13 +1176,13 @@ void ModelViewer::LoadItem(unsigned int id)
 
   try
   {
-    QString query = QString("SELECT ModelID, TextureID, ItemDisplayInfo.ID FROM ItemDisplayInfo "
-                            "LEFT JOIN ModelFileData ON ItemDisplayInfo.Model1 = ModelFileData.ID "
-                            "LEFT JOIN TextureFileData ON ItemDisplayInfo.TextureItemID1 = TextureFileData.ID "
-                            "WHERE ItemDisplayInfo.ID = (SELECT ItemDisplayInfoID FROM ItemAppearance WHERE ItemAppearance.ID = "
-                            "(SELECT ItemAppearanceID FROM ItemModifiedAppearance WHERE ItemID = %1))").arg(id);
+    QString query = "SELECT ModelID, TextureID, ItemDisplayInfo.ID FROM ItemDisplayInfo "
+                    "LEFT JOIN ModelFileData ON ItemDisplayInfo.Model1 = ModelFileData.ID "
+                    "LEFT JOIN TextureFileData ON ItemDisplayInfo.TextureItemID1 = TextureFileData.ID "
+                    "WHERE ItemDisplayInfo.ID = (SELECT ItemDisplayInfoID FROM ItemAppearance WHERE ItemAppearance.ID = "
+                    "(SELECT ItemAppearanceID FROM ItemModifiedAppearance WHERE ItemID = ?))";
 
-    sqlResult itemInfos = GAMEDATABASE.sqlQuery(query);
+    sqlResult itemInfos = GAMEDATABASE.sqlQuery(query, QVariantList() << id);
     // LOG_INFO << query;
 
     if (itemInfos.valid && !itemInfos.empty())
@@ -1356,6 +1364,28 @@ void ModelViewer::OnToggleCommand(wxCommandEvent &event)
       ResetLayout();
       break;
 
+    case ID_FILE_REBUILDDB:
+      if (core::Game::instance().initDone() && GAMEDATABASE.invalidateSnapshot())
+        wxMessageBox(wxT("Database will be rebuilt from game files on next start."), wxT("Rebuild Database"));
+      break;
+
+    case ID_FILE_QUERYREPORT:
+    {
+      if (!core::QueryProfiler::isEnabled())
+      {
+        wxMessageBox(wxT("Query profiling is disabled. Set Unofficial/ProfileQueries to true in config file and restart to enable it."), wxT("Query Profile Report"));
+        break;
+      }
+
+      if (!core::Game::instance().initDone())
+        break;
+
+      wxFileDialog dialog(this, wxT("Save query profile report"), wxEmptyString, wxT("queryprofile.txt"), wxT("Text files (*.txt)|*.txt"), wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+      if (dialog.ShowModal() == wxID_OK && GAMEDATABASE.queryProfiler().writeReport(QString(dialog.GetPath().c_str())))
+        LOG_INFO << "Query profile report saved to" << dialog.GetPath().c_str();
+    }
+    break;
+
     case ID_SHOW_MASK:
       video.useMasking = !video.useMasking;
       break;
@@ -1722,6 +1752,8 @@ void ModelViewer::LoadWoW()
   if (!core::Game::instance().initDone())
     core::Game::instance().init(new wow::WoWFolder(QString(gamePath.c_str())), new wow::WoWDatabase());
 
+  GAMEDIRECTORY.cache().setBudget((size_t)fileCacheSize * 1024 * 1024);
+
   // init game config
   std::vector<core::GameConfig> configsFound = GAMEDIRECTORY.configsFound();
   
@@ -1776,7 +1808,13 @@ void ModelViewer::LoadWoW()
   LOG_INFO << "Using following folder to read game info" << baseConfigFolder;
   core::Game::instance().setConfigFolder(baseConfigFolder);
 
-  GAMEDIRECTORY.initFromListfile("listfile.txt");
+  SetStatusText(wxT("Loading file list..."));
+  GAMEDIRECTORY.initFromListfile("listfile.txt", [this](unsigned int done, unsigned int total)
+  {
+    SetStatusText(wxString::Format(wxT("Loading file list... %d%%"), total ? (int)((100ull * done) / total) : 100));
+    GetStatusBar()->Update();
+  });
+  SetStatusText(wxEmptyString);
   
   if (!customDirectoryPath.IsEmpty())
     core::Game::instance().addCustomFiles(QString(customDirectoryPath.c_str()), customFilesConflictPolicy);
@@ -2425,14 +2463,14 @@ void ModelViewer::ImportArmoury(wxString strURL)
     }
 
     // retrieve model files id from DB
-    QString query = QString("SELECT CMDM.FileID as malemodel, CMDF.FileID AS femalemodel, CMDMHD.FileID as malemodelHD, CMDFHD.FileID AS femalemodelHD FROM ChrRaces "
-                            "LEFT JOIN CreatureDisplayInfo CDIM ON CDIM.ID = MaleDisplayID LEFT JOIN CreatureModelData CMDM ON CDIM.ModelID = CMDM.ID "
-                            "LEFT JOIN CreatureDisplayInfo CDIF ON CDIF.ID = FemaleDisplayID LEFT JOIN CreatureModelData CMDF ON CDIF.ModelID = CMDF.ID "
-                            "LEFT JOIN CreatureDisplayInfo CDIMHD ON CDIMHD.ID = HighResMaleDisplayId LEFT JOIN CreatureModelData CMDMHD ON CDIMHD.ModelID = CMDMHD.ID "
-                            "LEFT JOIN CreatureDisplayInfo CDIFHD ON CDIFHD.ID = HighResFemaleDisplayId LEFT JOIN CreatureModelData CMDFHD ON CDIFHD.ModelID = CMDFHD.ID "
-                            "WHERE ChrRaces.ID = %1").arg(result->raceId);
-
-    sqlResult r = GAMEDATABASE.sqlQuery(query);
+    QString query = "SELECT CMDM.FileID as malemodel, CMDF.FileID AS femalemodel, CMDMHD.FileID as malemodelHD, CMDFHD.FileID AS femalemodelHD FROM ChrRaces "
+                    "LEFT JOIN CreatureDisplayInfo CDIM ON CDIM.ID = MaleDisplayID LEFT JOIN CreatureModelData CMDM ON CDIM.ModelID = CMDM.ID "
+                    "LEFT JOIN CreatureDisplayInfo CDIF ON CDIF.ID = FemaleDisplayID LEFT JOIN CreatureModelData CMDF ON CDIF.ModelID = CMDF.ID "
+                    "LEFT JOIN CreatureDisplayInfo CDIMHD ON CDIMHD.ID = HighResMaleDisplayId LEFT JOIN CreatureModelData CMDMHD ON CDIMHD.ModelID = CMDMHD.ID "
+                    "LEFT JOIN CreatureDisplayInfo CDIFHD ON CDIFHD.ID = HighResFemaleDisplayId LEFT JOIN CreatureModelData CMDFHD ON CDIFHD.ModelID = CMDFHD.ID "
+                    "WHERE ChrRaces.ID = ?";
+
+    sqlResult r = GAMEDATABASE.sqlQuery(query, QVariantList() << result->raceId);
 
     if (!r.valid || r.values.empty())
     {
@@ -18,6 +18,7 @@ wxString armoryPath;
 wxString customDirectoryPath;
 int customFilesConflictPolicy = 0;
 int displayItemAndNPCId = 0;
+int fileCacheSize = 256;
 
 UserSkins userSkins;
 UserSkins& gUserSkins = userSkins;
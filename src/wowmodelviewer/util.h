@@ -37,6 +37,7 @@ extern wxString armoryPath;
 extern wxString customDirectoryPath;
 extern int customFilesConflictPolicy;
 extern int displayItemAndNPCId;
+extern int fileCacheSize; // in Mo
 
 extern bool useRandomLooks;
 